@@ -0,0 +1,14 @@
+# Turns a binary file into a C source file defining `<NAME>[]` and `<NAME>_size`.
+# Usage: cmake -DINPUT=<file> -DOUTPUT=<file.c> -DNAME=<symbol> -P embed_asset.cmake
+
+file(READ "${INPUT}" HEX_CONTENT HEX)
+file(SIZE "${INPUT}" CONTENT_SIZE)
+
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," BYTES "${HEX_CONTENT}")
+string(REPEAT "0x[0-9a-f][0-9a-f]," 16 LINE_PATTERN)
+string(REGEX REPLACE "(${LINE_PATTERN})" "\\1\n    " BYTES "${BYTES}")
+
+file(WRITE "${OUTPUT}"
+        "/* Generated from ${INPUT}, do not edit. */\n"
+        "const unsigned char ${NAME}[] = {\n    ${BYTES}\n};\n"
+        "const unsigned int ${NAME}_size = ${CONTENT_SIZE};\n")
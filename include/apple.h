@@ -1,22 +1,20 @@
 #ifndef APPLE_H
 #define APPLE_H
 
-#include "snake.h"
+#include "board.h"
+#include "rng.h"
+#include "timer.h"
 
-#define APPLE_TEXTURE_PATH WDIR "assets/apple.png"
-#define APPLE_SOUND_PATH   WDIR "assets/apple.wav"
 #define APPLE_SPAWN_DELAY 1.0
 typedef struct {
-    Texture2D texture;
-    Sound eating_sound;
-    Vector2 pos;
+    Cell pos;
     bool eaten;
     bool first_render;
     Timer timer;
 } Apple;
 
-void init_apple(Apple *apple, const Snake *snake, const Timer *timer);
+bool init_apple(Apple *apple, const Board *board, const Timer *timer, Rng *rng);
 
-void spawn_apple(Apple *apple, const Snake *snake);
+bool spawn_apple(Apple *apple, const Board *board, Rng *rng);
 
 #endif
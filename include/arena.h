@@ -0,0 +1,80 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "board.h"
+#include "game.h"
+#include "rng.h"
+#include "working_dir.h"
+
+#define ARENA_MAX_SNAKES 1024
+#define ARENA_MAX_APPLES 4096
+#define ARENA_SNAKE_LENGTH 3            // Length of a freshly spawned snake.
+#define ARENA_BODY_INITIAL_CAPACITY 16  // Initial ring buffer size per snake, a power of two.
+#define ARENA_SPAWN_ATTEMPTS 64         // Random spots tried for a snake or an apple before giving up.
+#define ARENA_AI_SIGHT 8                // Most distance an AI snake searches the board for apples before checking them all.
+
+/**
+ * @brief State of a game mode with many snakes and many apples on one board.
+ *
+ * Snakes are stored as a structure of arrays: each per-snake field lives in its own array indexed
+ * by snake, so a tick walks a few dense arrays (heads, directions, lengths, alive flags) instead of
+ * hopping between large per-snake structs. Only the body ring buffers are separate allocations,
+ * and a tick touches at most the head and tail slot of each.
+ *
+ * All snakes share one occupancy board, so a head running into any snake's body is a single bit
+ * lookup, and heads moving into the same cell are caught with two scratch bitsets; there are no
+ * pairwise checks between snakes.
+ *
+ * Apples are found through the board as well: each cell holds the index of its apple, so eating
+ * one and looking for the nearest one around a head never walk the whole apple list.
+ *
+ * Snakes 0 to player_count - 1 are steered with steer_arena_snake(), the others by a simple AI.
+ */
+typedef struct {
+    Board board;          // Cells covered by any snake.
+    int16_t *apple_slots; // Index of the apple on each cell, -1 for none.
+    uint64_t *claimed;    // Scratch bits: cells a head moves into during the current tick.
+    uint64_t *contested;  // Scratch bits: cells more than one head moves into during the current tick.
+    int32_t *apples;      // Cell index of each apple, -1 while it waits for a free cell.
+    int apple_count;
+    int ai_sight;         // Ring search distance of steer_ai(), smaller with few apples, see init_arena().
+
+    int snake_count;
+    int player_count;     // Number of snakes steered by players, they come first.
+    int alive_count;      // Number of snakes still alive.
+    int alive_players;    // Number of player snakes still alive.
+    uint64_t ticks;       // Number of ticks played.
+    Rng rng;              // The arena's own random number generator, for snake and apple placement.
+
+    // Per-snake state, one array per field.
+    Cell *heads;          // Position of each head.
+    Cell *next;           // Scratch: the cell each head moves into during the current tick.
+    Dir *directions;      // Direction of each head.
+    Dir *moved;           // Direction of each snake's last move; a turn may not reverse it.
+    int32_t *lengths;     // Number of segments of each snake.
+    int32_t *scores;      // Number of apples eaten by each snake.
+    uint8_t *alive;       // Whether each snake is still on the board.
+    uint8_t *fates;       // Scratch: what happens to each snake during the current tick.
+    int32_t **bodies;     // Ring buffer of cell indices of each snake, the head at head_slots.
+    int32_t *body_masks;  // Capacity - 1 of each ring buffer; capacities are powers of two.
+    int32_t *head_slots;  // Slot of each head in its ring buffer.
+} Arena;
+
+bool init_arena(Arena *arena, int cols, int rows, int snakes, int players, int apples, uint64_t seed);
+
+void free_arena(Arena *arena);
+
+void steer_arena_snake(Arena *arena, int snake, Dir direction);
+
+int tick_arena(Arena *arena);
+
+/**
+ * @brief Returns the cell index of a snake segment, 0 being the head.
+ */
+static inline int32_t arena_segment(const Arena *arena, int snake, int i) {
+    return arena->bodies[snake][(arena->head_slots[snake] - i) & arena->body_masks[snake]];
+}
+
+#endif
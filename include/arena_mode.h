@@ -0,0 +1,25 @@
+#ifndef ARENA_MODE_H
+#define ARENA_MODE_H
+
+#include "arena.h"
+#include "assets.h"
+
+#define DEFAULT_ARENA_PLAYERS 1
+#define ARENA_MAX_PLAYERS 2  // Arrow keys and WASD.
+#define ARENA_APPLES_PER_SNAKE 2  // Apples on the board per snake, when --apples is not given.
+#define ARENA_HUD_POSX 10
+#define ARENA_HUD_POSY 10
+#define ARENA_HUD_FONTSIZE 20
+
+/**
+ * @brief Command line settings of the multi-snake mode.
+ */
+typedef struct {
+    int snakes;   // Number of snakes; 0 plays the single-player game instead.
+    int players;  // How many of the snakes are steered from the keyboard, at most ARENA_MAX_PLAYERS.
+    int apples;   // Apples on the board at once; 0 picks ARENA_APPLES_PER_SNAKE per snake.
+} ArenaOptions;
+
+void run_arena(Arena *arena, Assets *assets, int tick_rate);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "audio_queue.h"
+#include "raylib.h"
+
+#define APPLE_SOUND_VOLUME 0.6f  // 0.0 - 1.0
+#define EATING_VOICES 4          // Eating sounds that can play over each other.
+#define AUDIO_POLL_INTERVAL 0.002  // Time the dispatcher sleeps when the queue is empty, in seconds.
+
+// Generated at build time from assets/ by cmake/embed_asset.cmake
+extern const unsigned char apple_png[];
+extern const unsigned int apple_png_size;
+#ifndef SNAKE_NO_AUDIO
+extern const unsigned char apple_wav[];
+extern const unsigned int apple_wav_size;
+#endif
+
+/**
+ * @brief The game's textures and sounds.
+ *
+ * The asset files are embedded into the binary, so the game does not depend on the directory
+ * it is launched from. Decoding them and initializing the audio device happen on a background
+ * thread while the window opens and the first frames render; the texture is uploaded as soon as
+ * its image is decoded and sounds are played once the audio device is ready.
+ *
+ * The loader thread then stays on as the audio dispatcher: the simulation only queues the events
+ * of its ticks (see queue_sounds()), and the dispatcher plays them, so a tick never waits for the
+ * audio backend. Each sound has a few aliases sharing its samples, played in turn, so eating
+ * apples in quick succession overlaps the sounds instead of restarting one.
+ * With SNAKE_NO_AUDIO (a CMake option), the audio device, the sounds and the queue are compiled out.
+ */
+typedef struct {
+    Texture2D apple_texture;  // id 0 until the image is decoded and uploaded.
+    Image apple_image;        // Decoded on the loader thread, uploaded by poll_assets().
+    atomic_bool image_ready;
+    atomic_bool audio_ready;
+    pthread_t loader;
+    bool loader_started;
+#ifndef SNAKE_NO_AUDIO
+    Sound eating_sound;                   // Valid once audio_ready is set.
+    Sound eating_voices[EATING_VOICES];   // Aliases of eating_sound, played in turn.
+    int next_voice;
+    AudioQueue events;                    // Events of the ticks, from the main thread to the dispatcher.
+    atomic_bool stop_audio;               // Set to end the dispatcher.
+#endif
+} Assets;
+
+void start_loading_assets(Assets *assets);
+
+void poll_assets(Assets *assets);
+
+bool assets_audio_ready(const Assets *assets);
+
+#ifdef SNAKE_NO_AUDIO
+
+static inline void queue_sounds(Assets *assets, int events) {
+    (void) assets;
+    (void) events;
+}
+
+#else
+
+void queue_sounds(Assets *assets, int events);
+
+#endif
+
+void unload_assets(Assets *assets);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef AUDIO_QUEUE_H
+#define AUDIO_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define AUDIO_QUEUE_SIZE 64  // Events the queue holds, a power of two; more are dropped until it drains.
+
+/**
+ * @brief A lock-free queue of GameEvent flags, from the simulation to the audio dispatcher.
+ *
+ * One thread pushes and one thread pops. Neither ever waits for the other: each side only writes
+ * its own index and reads the other's, so the simulation never blocks on the audio backend. When
+ * the dispatcher falls behind and the queue is full, new events are dropped and counted.
+ */
+typedef struct {
+    uint8_t events[AUDIO_QUEUE_SIZE];
+    atomic_uint head;   // Events popped so far, written by the consumer.
+    atomic_uint tail;   // Events pushed so far, written by the producer.
+    unsigned dropped;   // Events that found the queue full, written by the producer.
+} AudioQueue;
+
+void init_audio_queue(AudioQueue *queue);
+
+bool push_audio_event(AudioQueue *queue, int events);
+
+bool pop_audio_event(AudioQueue *queue, int *events);
+
+#endif
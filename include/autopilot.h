@@ -0,0 +1,53 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+/**
+ * @brief A computer player that follows shortest paths, with search buffers sized for one board.
+ *
+ * Each decision runs breadth-first searches over the board. The first finds a shortest path to
+ * the apple; it knows when each body cell will be left, so it can route through where the body
+ * is going to be gone. The path is only taken if, once the snake has followed it and grown, its
+ * head could still reach its tail, so it never walls itself in. Otherwise the snake chases its
+ * own tail the long way round, which keeps the most room free until the apple is safe again.
+ *
+ * The buffers are allocated once, and cells are marked visited by stamping them with the number
+ * of the current search, so a search never clears anything and never allocates. The same struct
+ * caches the board's Hamiltonian cycle for hamilton_decide().
+ */
+typedef struct {
+    int cols;              // Board size the buffers were allocated for.
+    int rows;
+    int32_t *queue;        // Search frontier, cell indices in the order they are reached.
+    uint32_t *visited;     // Number of the last search that reached each cell.
+    int32_t *parent;       // Cell each reached cell was reached from.
+    int32_t *free_after;   // Number of moves until each body cell is left, for the current decision.
+    uint32_t *path_mark;   // Number of the search whose path to the apple goes through each cell.
+    int32_t *path_step;    // Position of each cell on that path, 1 being the first move.
+    uint32_t search;       // Number of the current search.
+
+    int32_t *cycle;        // Position of each cell along a Hamiltonian cycle of the board, NULL if it has none.
+    int cycle_next;        // Cell the last cycle decision moved the head into, to notice other moves.
+    int cycle_length;      // Length of the snake at that decision.
+    int cycle_unordered;   // Number of tail-most segments that may lie out of order along the cycle.
+
+    long decisions;        // Number of decisions made.
+    long tail_chases;      // Decisions made without a safe path to the apple.
+    double total_time;     // Time spent deciding, in seconds.
+    double max_time;       // Longest decision, in seconds.
+} Autopilot;
+
+bool init_autopilot(Autopilot *autopilot, int cols, int rows);
+
+void free_autopilot(Autopilot *autopilot);
+
+Dir autopilot_decide(Autopilot *autopilot, const Game *game);
+
+void steer_autopilot(Autopilot *autopilot, Game *game);
+
+double average_autopilot_latency(const Autopilot *autopilot);
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "working_dir.h"
+
+#define BOARD_MIN_SIZE 8
+#define BOARD_MAX_SIZE 4096
+
+/**
+ * @brief Occupancy bitboard and free-cell index of the game board.
+ *
+ * One bit per cell, set while a snake segment covers the cell. The snake keeps it up to date
+ * incrementally (head in, tail out), so collision and "is this cell free" queries are constant
+ * time no matter how long the snake is.
+ *
+ * The free cells are also kept in a dense array, with a map from cell index to its slot in that
+ * array, so a uniformly random free cell can be picked in O(1) however full the board is.
+ *
+ * The board size is chosen at runtime, from BOARD_MIN_SIZE up to BOARD_MAX_SIZE cells per side,
+ * and the per-cell storage is allocated to match.
+ */
+typedef struct {
+    int cols;             // Number of columns.
+    int rows;             // Number of rows.
+    int cells;            // cols * rows.
+    uint64_t *occupied;   // One bit per cell.
+    int32_t *free_cells;  // Indices of the free cells, the first free_count entries are valid.
+    int32_t *free_slot;   // Position of each free cell in free_cells.
+    int free_count;       // Number of free cells.
+} Board;
+
+bool init_board(Board *board, int cols, int rows);
+
+void free_board(Board *board);
+
+void clear_board(Board *board);
+
+/*
+ * The helpers below come in two flavours: the cell_* ones take the board size as plain arguments,
+ * so code that is specialized for a fixed size (see tick_game()) gets them constant-folded, and the
+ * board_* ones read it from the Board.
+ */
+
+/**
+ * @brief Returns the linear index of a cell, row-major.
+ */
+static inline int cell_index(Cell cell, int cols) {
+    return cell.y * cols + cell.x;
+}
+
+/**
+ * @brief Checks whether a cell lies inside a board of the given size.
+ */
+static inline bool cell_in_bounds(Cell cell, int cols, int rows) {
+    return (unsigned) cell.x < (unsigned) cols && (unsigned) cell.y < (unsigned) rows;
+}
+
+/**
+ * @brief Returns the linear index of a cell, row-major.
+ */
+static inline int board_index(const Board *board, Cell cell) {
+    return cell_index(cell, board->cols);
+}
+
+/**
+ * @brief Returns the cell at a linear index.
+ */
+static inline Cell board_cell(const Board *board, int index) {
+    Cell cell = {index % board->cols, index / board->cols};
+    return cell;
+}
+
+/**
+ * @brief Checks whether a cell lies inside the board.
+ */
+static inline bool board_contains(const Board *board, Cell cell) {
+    return cell_in_bounds(cell, board->cols, board->rows);
+}
+
+/**
+ * @brief Checks whether the cell at a linear index is covered by the snake.
+ */
+static inline bool board_occupied_at(const Board *board, int i) {
+    return (board->occupied[i >> 6] >> (i & 63)) & 1u;
+}
+
+/**
+ * @brief Marks the cell at a linear index as covered.
+ *
+ * The cell is swap-removed from the free-cell array. Occupying a covered cell does nothing.
+ */
+static inline void board_occupy_at(Board *board, int i) {
+    uint64_t bit = (uint64_t) 1 << (i & 63);
+
+    if (board->occupied[i >> 6] & bit) {
+        return;
+    }
+    board->occupied[i >> 6] |= bit;
+
+    int slot = board->free_slot[i];
+    int last = board->free_cells[--board->free_count];
+    board->free_cells[slot] = last;
+    board->free_slot[last] = slot;
+}
+
+/**
+ * @brief Marks the cell at a linear index as free.
+ *
+ * The cell is appended to the free-cell array. Releasing a free cell does nothing.
+ */
+static inline void board_release_at(Board *board, int i) {
+    uint64_t bit = (uint64_t) 1 << (i & 63);
+
+    if (!(board->occupied[i >> 6] & bit)) {
+        return;
+    }
+    board->occupied[i >> 6] &= ~bit;
+
+    board->free_slot[i] = board->free_count;
+    board->free_cells[board->free_count++] = i;
+}
+
+/**
+ * @brief Checks whether a cell inside the board is covered by the snake.
+ */
+static inline bool board_occupied(const Board *board, Cell cell) {
+    return board_occupied_at(board, board_index(board, cell));
+}
+
+/**
+ * @brief Marks a cell inside the board as covered.
+ */
+static inline void board_occupy(Board *board, Cell cell) {
+    board_occupy_at(board, board_index(board, cell));
+}
+
+/**
+ * @brief Marks a cell inside the board as free.
+ */
+static inline void board_release(Board *board, Cell cell) {
+    board_release_at(board, board_index(board, cell));
+}
+
+/**
+ * @brief Checks whether a cell is inside the board and not covered by the snake.
+ */
+static inline bool board_cell_free(const Board *board, Cell cell) {
+    return board_contains(board, cell) && !board_occupied(board, cell);
+}
+
+#endif
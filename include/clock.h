@@ -0,0 +1,8 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+double clock_now(void);
+
+void clock_sleep(double seconds);
+
+#endif
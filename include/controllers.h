@@ -1,36 +1,37 @@
 #ifndef CONTROLLERS_H
 #define CONTROLLERS_H
 
-#include "snake.h"
-#include "timer.h"
-#include "apple.h"
+#include "raylib.h"
+#include "assets.h"
+#include "autopilot.h"
+#include "game.h"
+#include "input.h"
+#include "replay.h"
+#include "snapshot.h"
 
 #define RESTART_MSG "Press enter to restart"
 #define PAUSE_MSG "Game paused"
+#define WIN_MSG "Board full, you win! Press enter"
 #define PAUSE_OVERLAY (Color) { 128, 128, 128, 128 }
 #define FONT_SIZE 40
+#define REWIND_KEY KEY_BACKSPACE
+#define REWIND_SECONDS 10  // How far back the rewind key can go.
+#define AUTOPILOT_KEY KEY_TAB
+#define AUTOPILOT_MSG "Autopilot (tab to take over)"
+#define PROFILE_KEY KEY_F3  // Shows the frame profiler, in builds with SNAKE_PROFILE.
 
-/**
- * @brief Enum representing the different states of the game.
- *
- * PLAYING: The game is currently in progress.
- * PAUSE: The game is paused.
- * OVER: The game is over.
- */
-typedef enum {
-    PLAYING,
-    PAUSE,
-    OVER,
-} GameState;
+void handle_keys(InputQueue *input, const Snake *snake, GameState *state, bool *autopilot);
 
-void draw_grid(int cols, int rows, float cell_width, float cell_height);
+void handle_zoom(void);
 
-void handle_keys(Snake *snake, GameState *state);
+int update_game(Game *game, InputQueue *input, Autopilot *autopilot, Replay *replay, Assets *assets);
 
-void update_game(Snake *snake, Apple *apple, GameState *state);
+int update_replay(Game *game, ReplayPlayer *player, Assets *assets);
+
+bool rewind_game(Game *game, SnapshotRing *snapshots, Replay *replay);
 
 void draw_timer(const Timer *timer);
 
-void restart_game(Snake *snake, GameState *state);
+void restart_game(Game *game);
 
 #endif
@@ -0,0 +1,43 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "render_backend.h"
+
+/**
+ * @brief An RGBA image in memory, drawn into by the CPU rasterizer.
+ *
+ * Rectangles cover the pixels whose centers they contain, so rectangles that share an edge never
+ * overlap or leave a gap. Colors and images with an alpha below 255 are blended over the pixels
+ * already there. Fills and blends use SSE2 or NEON when the compiler targets them, and the same
+ * integer arithmetic otherwise, so every build draws the same pixels.
+ */
+typedef struct {
+    int width;
+    int height;
+    uint8_t *pixels;  // Rows from the top, 4 bytes per pixel in R, G, B, A order.
+} Framebuffer;
+
+bool init_framebuffer(Framebuffer *framebuffer, int width, int height);
+
+void free_framebuffer(Framebuffer *framebuffer);
+
+void clear_framebuffer(Framebuffer *framebuffer, RenderColor color);
+
+void fill_framebuffer_rect(Framebuffer *framebuffer, float x, float y, float width, float height, RenderColor color);
+
+void blit_framebuffer(Framebuffer *framebuffer, const Framebuffer *image, float x, float y, float width, float height,
+                      RenderColor tint);
+
+RenderBackend framebuffer_backend(Framebuffer *framebuffer);
+
+bool build_apple_sprite(Framebuffer *sprite, int size);
+
+bool save_framebuffer_png(const Framebuffer *framebuffer, const char *path);
+
+bool load_framebuffer_png(Framebuffer *framebuffer, const char *path);
+
+long compare_framebuffers(const Framebuffer *a, const Framebuffer *b, int tolerance);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "board.h"
+#include "snake.h"
+#include "apple.h"
+#include "rng.h"
+
+#define DEFAULT_TICK_RATE 20  // Simulation ticks (snake moves) per second.
+#define DEFAULT_COLS 32       // Board width used when Game.cols is left at 0.
+#define DEFAULT_ROWS 24       // Board height used when Game.rows is left at 0.
+
+/**
+ * @brief Enum representing the different states of the game.
+ *
+ * PLAYING: The game is currently in progress.
+ * PAUSE: The game is paused.
+ * OVER: The game is over.
+ * WON: The snake filled the whole board.
+ */
+typedef enum {
+    PLAYING,
+    PAUSE,
+    OVER,
+    WON,
+} GameState;
+
+/**
+ * @brief Bit flags describing what happened during a simulation tick.
+ *
+ * The simulation core reports events instead of playing sounds or drawing,
+ * so the caller decides what to do with them (or ignores them when headless).
+ */
+typedef enum {
+    GAME_EVENT_NONE = 0,
+    GAME_EVENT_ATE_APPLE = 1 << 0,
+    GAME_EVENT_DIED = 1 << 1,
+    GAME_EVENT_WON = 1 << 2,
+} GameEvent;
+
+/**
+ * @brief Structure holding the complete state of one game.
+ *
+ * Everything the rules need lives here and nothing in it depends on raylib,
+ * so a game can be simulated without a window, an audio device or a GPU.
+ */
+typedef struct {
+    Board board;
+    Snake snake;
+    Apple apple;
+    GameState state;
+    double elapsed;  // Simulated time since the game started, in seconds.
+    int tick_rate;   // Simulation ticks (snake moves) per second, independent of the frame rate.
+    int cols;        // Requested board width, applied by init_game().
+    int rows;        // Requested board height, applied by init_game().
+    uint64_t seed;   // Seed of the game, applied by init_game(); with the inputs, it determines the whole game.
+    Rng rng;         // The game's own random number generator, for the snake and apple placement.
+} Game;
+
+bool init_game(Game *game);
+
+void free_game(Game *game);
+
+int tick_game(Game *game, double dt);
+
+double tick_interval(const Game *game);
+
+#endif
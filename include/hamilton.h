@@ -0,0 +1,26 @@
+#ifndef HAMILTON_H
+#define HAMILTON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "autopilot.h"
+#include "game.h"
+
+/**
+ * @brief Checks whether a board has a Hamiltonian cycle, a closed path through every cell once.
+ *
+ * Every board with an even number of cells has one; a board with an odd number of cells has none,
+ * since any closed path on a grid alternates between two colours of a checkerboard.
+ *
+ * @param cols The number of columns of the board.
+ * @param rows The number of rows of the board.
+ */
+static inline bool has_hamilton_cycle(int cols, int rows) {
+    return cols >= 2 && rows >= 2 && (cols % 2 == 0 || rows % 2 == 0);
+}
+
+void build_hamilton_cycle(int32_t *position, int cols, int rows);
+
+Dir hamilton_decide(Autopilot *autopilot, const Game *game);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include "snake.h"
+
+#define INPUT_QUEUE_SIZE 8
+
+/**
+ * @brief Queue of turns pressed by the player and not yet applied to the snake.
+ *
+ * Key presses are queued as they are polled, every frame, and the simulation applies at most
+ * one turn per tick. Quick double turns are therefore kept instead of being lost between ticks.
+ * Each turn carries the time it was pressed, so the delay until the snake actually turns can be
+ * measured.
+ */
+typedef struct {
+    Dir turns[INPUT_QUEUE_SIZE];
+    double pressed_at[INPUT_QUEUE_SIZE];
+    int first;              // Index of the oldest queued turn.
+    int count;              // Number of queued turns.
+    double latency_total;   // Sum of the input-to-move delays of all applied turns, in seconds.
+    double latency_max;     // Longest input-to-move delay seen, in seconds.
+    int latency_samples;    // Number of applied turns.
+} InputQueue;
+
+void init_input_queue(InputQueue *input);
+
+void clear_input_queue(InputQueue *input);
+
+bool push_turn(InputQueue *input, const Snake *snake, Dir dir, double now);
+
+bool apply_turn(InputQueue *input, Snake *snake, double now);
+
+double average_input_latency(const InputQueue *input);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LEADERBOARD_SIZE 10
+#define LEADERBOARD_MAGIC 0x424C4E53u  // "SNLB" in a little-endian file
+#define LEADERBOARD_VERSION 1
+
+/**
+ * @brief One finished game on the leaderboard. 32 bytes, stored as is in the file.
+ */
+typedef struct {
+    int32_t score;         // Apples eaten.
+    int32_t length;        // Length of the snake at the end of the game.
+    uint32_t duration_ms;  // Simulated duration of the game, in milliseconds.
+    uint32_t reserved;     // Always 0, keeps the 64-bit fields aligned.
+    uint64_t seed;         // Seed of the game's random number generator.
+    int64_t timestamp;     // Unix time at which the game ended.
+} LeaderboardEntry;
+
+/**
+ * @brief Layout of the leaderboard file: a small header followed by the entries, best first.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;     // Number of valid entries.
+    uint32_t checksum;  // FNV-1a over count and entries, detects torn or corrupt files.
+    LeaderboardEntry entries[LEADERBOARD_SIZE];
+} LeaderboardFile;
+
+/**
+ * @brief A leaderboard file mapped read-only into memory.
+ *
+ * Reading entries only touches the mapping, so showing the leaderboard costs no I/O.
+ * Updates go through a temporary file that is synced and renamed over the old one,
+ * so a crash leaves either the old or the new leaderboard, never a torn one.
+ */
+typedef struct {
+    const LeaderboardFile *file;  // The mapped file, NULL if there is none yet or it is invalid.
+    size_t mapped_size;
+    bool invalid;                 // The file exists but failed validation.
+} Leaderboard;
+
+bool open_leaderboard(Leaderboard *leaderboard, const char *path);
+
+void close_leaderboard(Leaderboard *leaderboard);
+
+int leaderboard_count(const Leaderboard *leaderboard);
+
+const LeaderboardEntry *leaderboard_entry(const Leaderboard *leaderboard, int rank);
+
+bool leaderboard_insert(Leaderboard *leaderboard, const char *path, const LeaderboardEntry *entry);
+
+#endif
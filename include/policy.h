@@ -0,0 +1,27 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include "autopilot.h"
+#include "game.h"
+
+/**
+ * @brief A computer player: picks the snake's direction for the next tick.
+ *
+ * Policies only read the game, so the same policy can play any number of games at once,
+ * one per thread. Random decisions are drawn from a generator owned by the caller, not from the
+ * game's, so the game's own sequence only depends on its seed and the moves made. Policies that
+ * search the board use the caller's Autopilot buffers, sized for the game's board.
+ * apply_policy() turns the decision into a move.
+ */
+typedef struct {
+    const char *name;                                               // Name used on the command line.
+    Dir (*decide)(const Game *game, Rng *rng, Autopilot *search);  // Returns the direction for the next tick.
+} Policy;
+
+const Policy *find_policy(const char *name);
+
+void list_policies(char *buffer, int size);
+
+void apply_policy(Game *game, const Policy *policy, Rng *rng, Autopilot *search);
+
+#endif
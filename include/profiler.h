@@ -0,0 +1,60 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include "clock.h"
+
+#define PROFILE_HISTORY 256           // Frames the statistics cover, per phase.
+#define PROFILE_TRACE_EVENTS 65536    // Events kept for the trace file, the oldest are dropped.
+
+/**
+ * @brief The parts of a frame that are timed.
+ */
+typedef enum {
+    PROFILE_FRAME,    // The whole frame, vsync wait included.
+    PROFILE_INPUT,    // Reading the keyboard.
+    PROFILE_UPDATE,   // The simulation ticks run this frame.
+    PROFILE_GRID,     // Drawing the board.
+    PROFILE_SNAKE,
+    PROFILE_APPLE,
+    PROFILE_HUD,      // Score, high score, timer and messages.
+    PROFILE_PRESENT,  // EndDrawing(), where the frame waits for vsync.
+    PROFILE_PHASES
+} ProfilePhase;
+
+/**
+ * @brief Statistics of a phase over the last PROFILE_HISTORY frames, in milliseconds.
+ */
+typedef struct {
+    double min;
+    double avg;
+    double p99;
+    int samples;
+} ProfileStats;
+
+const char *profile_phase_name(ProfilePhase phase);
+
+void profile_record(ProfilePhase phase, double start, double end);
+
+ProfileStats profile_stats(ProfilePhase phase);
+
+bool export_profile_trace(const char *path);
+
+/*
+ * PROFILE_BEGIN(phase) and PROFILE_END(phase) time the code between them as one sample of the
+ * phase, and must be used in pairs within the same block. Without SNAKE_PROFILE (a CMake option)
+ * they expand to nothing, so the instrumentation costs nothing in a normal build.
+ */
+#ifdef SNAKE_PROFILE
+
+#define PROFILE_BEGIN(phase) const double profile_start_##phase = clock_now()
+#define PROFILE_END(phase) profile_record(phase, profile_start_##phase, clock_now())
+
+#else
+
+#define PROFILE_BEGIN(phase) ((void) 0)
+#define PROFILE_END(phase) ((void) 0)
+
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "raylib.h"
+#include "arena.h"
+#include "game.h"
+#include "snake_mesh.h"
+
+void set_render_board(int cols, int rows);
+
+void update_camera(Cell prev_head, Cell head, float alpha);
+
+void zoom_camera(float factor);
+
+void begin_board_view(void);
+
+void end_board_view(void);
+
+void draw_grid(void);
+
+void unload_grid(void);
+
+void draw_snake(const Snake *snake, SnakeMesh *mesh, float alpha);
+
+void draw_apple(const Apple *apple, Texture2D texture);
+
+void draw_arena_snakes(const Arena *arena);
+
+void draw_arena_apples(const Arena *arena, Texture2D texture);
+
+void draw_textured_rectangle(Cell position, Texture2D texture, Color tint);
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "apple.h"
+#include "snake.h"
+#include "snake_mesh.h"
+
+// raylib's palette, for backends that do not include raylib
+#define RENDER_RAYWHITE (RenderColor) {245, 245, 245, 255}
+#define RENDER_LIGHTGRAY (RenderColor) {200, 200, 200, 255}
+#define RENDER_LIME (RenderColor) {0, 158, 47, 255}
+#define RENDER_DARKGREEN (RenderColor) {0, 117, 44, 255}
+#define RENDER_RED (RenderColor) {230, 41, 55, 255}
+#define RENDER_DARKRED (RenderColor) {204, 4, 4, 255}
+#define RENDER_WHITE (RenderColor) {255, 255, 255, 255}
+
+/**
+ * @brief An RGBA color, laid out like raylib's Color.
+ */
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+} RenderColor;
+
+/**
+ * @brief Where the board lands on the render target, and which of its cells are visible.
+ */
+typedef struct {
+    int cols;            // Board size.
+    int rows;
+    float cell_size;     // Size of a cell on the target.
+    float origin_x;      // Position of the board's top-left corner on the target.
+    float origin_y;
+    int x0;              // Visible cells, inclusive bounds; empty when x1 < x0 or y1 < y0.
+    int y0;
+    int x1;
+    int y1;
+} RenderView;
+
+/**
+ * @brief The drawing primitives a render target provides.
+ *
+ * The scene functions below only draw through these, so the same snake, grid and apple go to
+ * raylib in the game and to a CPU framebuffer in headless runs (see framebuffer_backend()).
+ * Images are whatever the backend draws from, a Texture2D for raylib and a Framebuffer for the
+ * CPU rasterizer.
+ */
+typedef struct {
+    void *target;
+    // Called before a run of at most count fill_rect() calls, and after it, so backends can batch them.
+    void (*begin_rects)(void *target, int count);
+    void (*fill_rect)(void *target, float x, float y, float width, float height, RenderColor color);
+    void (*end_rects)(void *target);
+    void (*draw_image)(void *target, const void *image, float x, float y, float width, float height,
+                       RenderColor tint);
+} RenderBackend;
+
+void fit_render_view(RenderView *view, int cols, int rows, int width, int height);
+
+void draw_grid_lines(const RenderBackend *backend, const RenderView *view);
+
+void draw_snake_scene(const RenderBackend *backend, const RenderView *view, const Snake *snake, SnakeMesh *mesh,
+                      float alpha);
+
+void draw_apple_scene(const RenderBackend *backend, const RenderView *view, const Apple *apple, const void *image);
+
+#endif
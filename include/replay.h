@@ -0,0 +1,100 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+
+#define REPLAY_MAGIC 0x50524E53u  // "SNRP" in a little-endian file
+#define REPLAY_VERSION 1
+#define REPLAY_INITIAL_CAPACITY 256
+
+/**
+ * @brief Layout of the start of a replay file, followed by data_size bytes of events.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;         // Seed of the game.
+    int32_t cols;          // Board size.
+    int32_t rows;
+    int32_t tick_rate;     // Ticks per second, the spawn timer depends on the tick length.
+    uint32_t ticks;        // Number of ticks played.
+    int32_t score;         // Outcome of the game, to check playback against.
+    int32_t length;
+    uint32_t event_count;  // Number of recorded turns.
+    uint32_t data_size;    // Size of the encoded events, in bytes.
+    uint32_t checksum;     // FNV-1a over the encoded events.
+    uint32_t reserved;     // Always 0, keeps the header a multiple of 8 bytes.
+} ReplayHeader;
+
+/**
+ * @brief A game recorded as its seed plus the turns the player made.
+ *
+ * The seed fixes every random placement, so the turns are all that is needed to play the game
+ * again. A turn is stored only when the snake's direction changes (and once when it starts
+ * moving), as one varint holding the number of ticks since the previous turn and the new
+ * direction, so most turns take a single byte and a long game fits in a few kilobytes.
+ */
+typedef struct {
+    ReplayHeader header;
+    uint8_t *data;            // Encoded turns.
+    size_t capacity;          // Allocated size of data.
+    uint32_t last_turn_tick;  // Tick of the last recorded turn.
+    Dir last_direction;       // Direction of the last recorded turn.
+    bool moving;              // Whether a turn has been recorded yet.
+    bool failed;              // Whether a turn could not be stored; the recording is incomplete.
+} Replay;
+
+/**
+ * @brief Plays a replay's turns back into a game, tick by tick.
+ */
+typedef struct {
+    const Replay *replay;
+    size_t offset;      // Read position in the encoded turns.
+    uint32_t tick;      // Ticks played back so far.
+    uint32_t next_tick; // Tick of the next turn.
+    Dir next_direction; // Direction of the next turn.
+    bool has_next;      // Whether there is a next turn.
+} ReplayPlayer;
+
+void start_replay(Replay *replay, const Game *game);
+
+void record_turn(Replay *replay, Dir direction);
+
+void finish_replay(Replay *replay, const Game *game);
+
+void free_replay(Replay *replay);
+
+bool save_replay(const Replay *replay, const char *path);
+
+bool load_replay(Replay *replay, const char *path);
+
+void setup_replay_game(const Replay *replay, Game *game);
+
+void start_playback(ReplayPlayer *player, const Replay *replay);
+
+bool playback_tick(ReplayPlayer *player, Snake *snake);
+
+void rewind_replay(Replay *replay, uint32_t ticks);
+
+bool verify_replay(const Replay *replay, Game *game);
+
+/**
+ * @brief Records the snake's direction for the tick about to be simulated.
+ *
+ * Must be called once per tick, after the player's input is applied and before tick_game().
+ * Costs a comparison unless the direction changed.
+ *
+ * @param replay A pointer to the Replay being recorded.
+ * @param snake A pointer to the snake about to move.
+ */
+static inline void record_tick(Replay *replay, const Snake *snake) {
+    if (snake->has_moved && (!replay->moving || snake->direction != replay->last_direction)) {
+        record_turn(replay, snake->direction);
+    }
+    replay->header.ticks++;
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * @brief State of a xoshiro256** pseudo-random number generator.
+ *
+ * Every game owns one, seeded explicitly, so a seed and the player's inputs fully determine a game
+ * and games running on different threads share no state. 32 bytes, a few cycles per number.
+ */
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+void rng_seed(Rng *rng, uint64_t seed);
+
+uint64_t rng_next(Rng *rng);
+
+int rng_range(Rng *rng, int min, int max);
+
+#endif
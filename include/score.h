@@ -1,24 +1,44 @@
 #ifndef SCORE_H
 #define SCORE_H
 
+#include <stdint.h>
 #include "working_dir.h"
 
 #define SCORE_DIR_PATH WDIR "data/"
-#define SCORE_TXT_PATH WDIR "data/highest_score.txt"
+#define SCORE_DB_PATH  WDIR "data/leaderboard.bin"
+#define SCORE_TXT_PATH WDIR "data/highest_score.txt"  // Legacy single-score file, imported once
+#define REPLAY_DIR_PATH WDIR "data/replays/"
+#define PROFILE_TRACE_PATH WDIR "data/profile_trace.json"
 #define SCORE_POSX 10
 #define SCORE_POSY 8
 #define SCORE_FONTSIZE 20
+#define LEADERBOARD_POSY 420
+#define LEADERBOARD_LINE_HEIGHT 24
+#define PROFILE_POSX 230  // Right of the elapsed time.
+#define PROFILE_POSY 80
+#define PROFILE_FONTSIZE 10
+#define PROFILE_LINE_HEIGHT 12
 
 #define IO_WARNING_1 "ERROR: Error while initializing score\n"
 #define IO_WARNING_2 "WARNING: Error while reading score\n"
 #define IO_WARNING_3 "WARNING: Error while writing score\n"
 
+void ensure_dir_exists(const char *dir);
+
 void init_score(void);
 
 int load_highest_score(void);
 
-void save_highest_score(int score);
+void save_score(int score, int length, double duration, uint64_t seed);
+
+void flush_scores(void);
+
+void close_score(void);
 
 void draw_score(int current_core, int highest_core);
 
+void draw_leaderboard(int x, int y);
+
+void draw_profiler(int x, int y);
+
 #endif //SCORE_H
@@ -2,11 +2,12 @@
 #ifndef SNAKE_H
 #define SNAKE_H
 
-#include "raylib.h"
-#include "timer.h"
+#include <stdbool.h>
+#include "rng.h"
 #include "working_dir.h"
 
 #define MIN_SCORE_FOR_RED_SNAKE 50
+#define SNAKE_INITIAL_CAPACITY 64
 
 
 
@@ -17,9 +18,16 @@
  * It includes the positions of the snake's body parts, the current direction of the snake's head,
  * the current length of the snake, the current score of the snake, and a flag to indicate whether
  * the snake has moved in the current frame.
+ *
+ * The body is a ring buffer: moving writes the new head and forgets the tail, and growing simply
+ * keeps the tail, so both are O(1). The buffer doubles on demand; the game caps the length at the board area.
  */
 typedef struct {
-    Vector2 pos[100];  // Array to store the positions of the snake's body parts.
+    Cell *body;        // Ring buffer with the positions of the snake's body parts.
+    int capacity;      // Number of slots in body, always a power of two.
+    int head;          // Index of the head segment in body.
+    Cell prev_head;    // Head position before the last tick, used to interpolate rendering.
+    Cell prev_tail;    // Tail position before the last tick, used to interpolate rendering.
     Dir direction;     // The current direction of the snake's head.
     int length;        // The current length of the snake.
     int score;         // The current score of the snake.
@@ -27,10 +35,33 @@ typedef struct {
 } Snake;
 
 
-void init_snake(Snake *snake);
+void init_snake(Snake *snake, int cols, int rows, Rng *rng);
+
+void free_snake(Snake *snake);
+
+bool reserve_snake(Snake *snake, int length);
 
-void draw_snake(Snake *snake);
+bool advance_snake(Snake *snake, Cell next, bool grow);
+
+/**
+ * @brief Returns the i-th segment of the snake, 0 being the head.
+ */
+static inline Cell snake_segment(const Snake *snake, int i) {
+    return snake->body[(snake->head - i) & (snake->capacity - 1)];
+}
 
-void draw_textured_rectangle(Vector2 position, Texture2D texture, Color tint);
+/**
+ * @brief Returns the position of the snake's head.
+ */
+static inline Cell snake_head(const Snake *snake) {
+    return snake->body[snake->head];
+}
+
+/**
+ * @brief Returns the position of the snake's last segment.
+ */
+static inline Cell snake_tail(const Snake *snake) {
+    return snake_segment(snake, snake->length - 1);
+}
 
 #endif
@@ -0,0 +1,48 @@
+#ifndef SNAKE_MESH_H
+#define SNAKE_MESH_H
+
+#include <stdbool.h>
+#include "snake.h"
+
+#define SNAKE_MESH_INITIAL_CAPACITY 16
+
+/**
+ * @brief A straight run of snake segments, from its tail-side end to its head-side end.
+ *
+ * Consecutive runs share the corner cell between them.
+ */
+typedef struct {
+    Cell from;
+    Cell to;
+} SnakeRun;
+
+/**
+ * @brief The snake's body merged into straight runs, ready to be submitted as one quad per run.
+ *
+ * Runs are kept in a ring buffer, oldest (tail) first. sync_snake_mesh() follows the snake one tick
+ * at a time by extending or adding a run at the head and shrinking or dropping one at the tail,
+ * so the mesh is only rebuilt from scratch when the snake jumps (restart, rewind...).
+ */
+typedef struct {
+    SnakeRun *runs;
+    int capacity;  // Number of slots in runs, always a power of two.
+    int first;     // Index of the tail run.
+    int count;     // Number of runs.
+} SnakeMesh;
+
+void init_snake_mesh(SnakeMesh *mesh);
+
+void free_snake_mesh(SnakeMesh *mesh);
+
+void rebuild_snake_mesh(SnakeMesh *mesh, const Snake *snake);
+
+void sync_snake_mesh(SnakeMesh *mesh, const Snake *snake);
+
+/**
+ * @brief Returns the i-th run of the mesh, 0 being the run at the tail.
+ */
+static inline SnakeRun *snake_mesh_run(const SnakeMesh *mesh, int i) {
+    return &mesh->runs[(mesh->first + i) & (mesh->capacity - 1)];
+}
+
+#endif
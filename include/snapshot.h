@@ -0,0 +1,46 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "game.h"
+
+#define SNAPSHOT_RING_MAX_BYTES (64u << 20)  // Memory a ring may use; large boards get fewer snapshots.
+
+/**
+ * @brief A preallocated ring of game snapshots, the newest overwriting the oldest once it is full.
+ *
+ * Every snapshot of a ring has the same fixed size, enough for any state of a game on the
+ * ring's board: the scalar state (snake, apple and its timer, game state, generator) plus the
+ * board's occupancy bits, its free cells and the snake's body. Taking or restoring a snapshot
+ * copies only what is in use, so its cost grows with the board size, not with the ring's.
+ */
+typedef struct {
+    unsigned char *slots;  // capacity snapshots of slot_size bytes each.
+    size_t slot_size;      // Size of one snapshot, see snapshot_size().
+    int capacity;          // Number of snapshots the ring can hold.
+    int count;             // Number of snapshots held.
+    int newest;            // Slot of the newest snapshot.
+    int cols;              // Board size the ring was allocated for.
+    int rows;
+} SnapshotRing;
+
+size_t snapshot_size(int cols, int rows);
+
+void take_snapshot(void *snapshot, const Game *game);
+
+bool restore_snapshot(const void *snapshot, Game *game);
+
+bool init_snapshot_ring(SnapshotRing *ring, int cols, int rows, int capacity);
+
+void free_snapshot_ring(SnapshotRing *ring);
+
+void clear_snapshot_ring(SnapshotRing *ring);
+
+void push_snapshot(SnapshotRing *ring, const Game *game);
+
+bool restore_from_ring(const SnapshotRing *ring, int age, Game *game);
+
+bool rewind_ring(SnapshotRing *ring, Game *game);
+
+#endif
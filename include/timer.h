@@ -15,7 +15,7 @@ void start_timer(Timer *timer, double lifetime);
 
 void reset_timer(Timer *timer, double duration);
 
-void update_timer(Timer *timer);
+void update_timer(Timer *timer, double dt);
 
 bool timer_done(const Timer *timer);
 
@@ -1,12 +1,14 @@
 #ifndef WINDOW_H
 #define WINDOW_H
 #define WINDOW_TITLE "Snaku Gaima"
-#define COLS 32
-#define ROWS 24
 #define SCREEN_WIDTH 960.0
 #define SCREEN_HEIGHT 720.0
 #define HALF_SCREEN_W (SCREEN_WIDTH / 2)
 #define HALF_SCREEN_H (SCREEN_HEIGHT / 2)
-#define CELL_WIDTH (SCREEN_WIDTH / COLS)
-#define CELL_HEIGHT (SCREEN_HEIGHT / ROWS)
+#define CELL_SIZE 30.0f  // Size of a board cell at zoom 1, in pixels
+#define MIN_CAMERA_ZOOM (1.0f / CELL_SIZE)  // Zooming out stops at one pixel per cell
+#define MAX_CAMERA_ZOOM 4.0f
+#define CAMERA_ZOOM_STEP 1.25f  // Zoom factor of one key press or mouse wheel notch
+#define MIN_GRID_CELL_SIZE 4.0  // Grid lines are not drawn when cells are smaller than this, in pixels
+#define MAX_FRAME_TIME 0.25  // Longest frame the simulation catches up on, avoids a spiral of ticks after a stall
 #endif
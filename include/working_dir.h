@@ -14,4 +14,15 @@ typedef enum {
     UP,     ///< Represents the up direction.
     DOWN,   ///< Represents the down direction.
 } Dir;
+
+/**
+ * @brief A cell on the game board, in grid coordinates.
+ *
+ * Cells are integral so that the simulation core never has to compare floats
+ * and never depends on raylib's Vector2.
+ */
+typedef struct {
+    int x;  ///< Column of the cell, 0 is the left edge.
+    int y;  ///< Row of the cell, 0 is the top edge.
+} Cell;
 #endif
@@ -1,84 +1,72 @@
 
 
 #include "../include//apple.h"
-#include "../include//window.h"
-#include <stdbool.h>  // Add missing include for bool type
+#include <stdbool.h>
 #include <stddef.h>
-// Make sure we have access to COLS and ROWS definitions
-#define COLS 32
-#define ROWS 24
-#define APPLE_SPAWN_DELAY 500  // Add missing definition
 
 /**
  * @brief Initializes the apple object with a random position that is not on the snake's body.
  *
+ * The position is drawn uniformly from the board's free-cell array, so this takes constant time
+ * however full the board is.
+ *
  * @param apple Pointer to the apple object to be initialized.
- * @param snake Pointer to the snake object.
+ * @param board Pointer to the occupancy board.
  * @param timer Pointer to the timer object used to control apple spawning.
+ * @param rng Pointer to the game's random number generator.
+ *
+ * @return true if the apple was placed, false if the board has no free cell left.
  */
-void init_apple(Apple *apple, const Snake *snake, const Timer *timer) {
+bool init_apple(Apple *apple, const Board *board, const Timer *timer, Rng *rng) {
     apple->timer = *timer;
 
-    do {
-        apple->pos.x = (float) GetRandomValue(0, COLS - 1);
-        apple->pos.y = (float) GetRandomValue(0, ROWS - 1);
-
-        bool valid_pos = true;
-
-        for (int i = 0; i < snake->length; i++) {
-            if (apple->pos.x == snake->pos[i].x && apple->pos.y == snake->pos[i].y) {
-                valid_pos = false;
-                break;
-            }
-        }
-
-        if (valid_pos) {
-            break;
-        }
+    if (board->free_count == 0) {
+        return false;
+    }
 
-    } while (true);
+    apple->pos = board_cell(board, board->free_cells[rng_range(rng, 0, board->free_count - 1)]);
+    return true;
 }
 
 /**
- * @brief Spawns an apple on the game window.
+ * @brief Spawns an apple on the game board.
  *
- * This function handles the spawning of the apple on the game window. It checks if the apple has been eaten and if the timer for spawning is done.
+ * This function handles the spawning of the apple on the game board. It checks if the apple has been eaten and if the timer for spawning is done.
  * If the apple has been eaten and the timer is done, it resets the timer and re-initializes the apple with a new random position.
- * If the apple has not been eaten or the timer is not done, it simply draws the apple on the game window.
- * The function includes safety checks to prevent any rendering issues or potential segmentation faults.
+ * The function includes safety checks to prevent any out-of-bounds apple positions.
+ * Drawing the apple is left to the renderer, so this function can run headless.
  *
  * @param apple Pointer to the apple object.
- * @param snake Pointer to the snake object.
+ * @param board Pointer to the occupancy board.
+ * @param rng Pointer to the game's random number generator.
+ *
+ * @return false if the apple had to be placed but the board is full, true otherwise.
  */
-void spawn_apple(Apple *apple, const Snake *snake) {
+bool spawn_apple(Apple *apple, const Board *board, Rng *rng) {
     // Safety check for null pointers
-    if (apple == NULL || snake == NULL) {
-        return;
-    }
-    
-    // Validate snake length to prevent accessing out-of-bounds memory
-    if (snake->length <= 0 || snake->length > 100) {
-        return;
+    if (apple == NULL || board == NULL) {
+        return true;
     }
 
     if (apple->first_render) {
-        init_apple(apple, snake, &apple->timer);
+        if (!init_apple(apple, board, &apple->timer, rng))
+            return false;
         apple->first_render = false;
         apple->eaten = false;
     } else {
         if (apple->eaten && timer_done(&apple->timer)) {
             reset_timer(&apple->timer, APPLE_SPAWN_DELAY);
-            init_apple(apple, snake, &apple->timer);
+            if (!init_apple(apple, board, &apple->timer, rng))
+                return false;
             apple->eaten = false;
         }
     }
 
-    // Safety check for apple position before rendering
-    if (apple->pos.x < 0 || apple->pos.x >= COLS || apple->pos.y < 0 || apple->pos.y >= ROWS) {
+    // Safety check for apple position
+    if (!board_contains(board, apple->pos)) {
         // Attempt to recover by reinitializing the apple
-        init_apple(apple, snake, &apple->timer);
+        return init_apple(apple, board, &apple->timer, rng);
     }
 
-    if (!apple->timer.active || timer_done(&apple->timer))
-        draw_textured_rectangle(apple->pos, apple->texture, WHITE);
-}
\ No newline at end of file
+    return true;
+}
@@ -0,0 +1,486 @@
+#include "../include//arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_SETUP_ERROR "ERROR: An arena needs 1 to %d snakes, at most one player per snake and 1 to %d apples\n"
+#define ARENA_ALLOC_ERROR "ERROR: Out of memory while allocating an arena of %d snakes\n"
+
+/**
+ * @brief What happens to a snake during a tick.
+ */
+enum {
+    FATE_IDLE,   // Dead before the tick.
+    FATE_MOVES,  // Moves, the tail follows.
+    FATE_GROWS,  // Moves onto an apple and keeps its tail.
+    FATE_DIES,   // Hits a wall, a body or another head.
+};
+
+static const int DIR_DX[] = {[LEFT] = -1, [RIGHT] = 1, [UP] = 0, [DOWN] = 0};
+static const int DIR_DY[] = {[LEFT] = 0, [RIGHT] = 0, [UP] = -1, [DOWN] = 1};
+static const Dir DIR_REVERSE[] = {[LEFT] = RIGHT, [RIGHT] = LEFT, [UP] = DOWN, [DOWN] = UP};
+static const Dir DIR_TURN_LEFT[] = {[LEFT] = DOWN, [RIGHT] = UP, [UP] = LEFT, [DOWN] = RIGHT};
+static const Dir DIR_TURN_RIGHT[] = {[LEFT] = UP, [RIGHT] = DOWN, [UP] = RIGHT, [DOWN] = LEFT};
+
+static inline bool bit_test(const uint64_t *bits, int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1u;
+}
+
+static inline void bit_set(uint64_t *bits, int i) {
+    bits[i >> 6] |= (uint64_t) 1 << (i & 63);
+}
+
+static inline void bit_clear(uint64_t *bits, int i) {
+    bits[i >> 6] &= ~((uint64_t) 1 << (i & 63));
+}
+
+static inline Cell step_cell(Cell cell, Dir direction) {
+    Cell next = {cell.x + DIR_DX[direction], cell.y + DIR_DY[direction]};
+    return next;
+}
+
+/**
+ * @brief Places a snake of ARENA_SNAKE_LENGTH segments in a straight line on free cells.
+ *
+ * A few random spots are tried; the cell in front of the head must be free too, so that no snake
+ * starts facing a wall or another snake.
+ *
+ * @return true if the snake was placed, false if it starts the game dead.
+ */
+static bool spawn_snake(Arena *arena, int snake) {
+    Board *board = &arena->board;
+
+    for (int attempt = 0; attempt < ARENA_SPAWN_ATTEMPTS && board->free_count > 0; attempt++) {
+        Cell head = board_cell(board, board->free_cells[rng_range(&arena->rng, 0, board->free_count - 1)]);
+        Dir direction = (Dir) rng_range(&arena->rng, 0, 3);
+        Dir back = DIR_REVERSE[direction];
+
+        bool fits = board_cell_free(board, step_cell(head, direction));
+        Cell cell = head;
+        for (int i = 0; i < ARENA_SNAKE_LENGTH && fits; i++) {
+            fits = board_cell_free(board, cell) && arena->apple_slots[board_index(board, cell)] < 0;
+            cell = step_cell(cell, back);
+        }
+
+        if (!fits) {
+            continue;
+        }
+
+        // The tail sits in slot 0 and the head in the last used slot
+        cell = head;
+        arena->head_slots[snake] = ARENA_SNAKE_LENGTH - 1;
+        for (int i = 0; i < ARENA_SNAKE_LENGTH; i++) {
+            arena->bodies[snake][ARENA_SNAKE_LENGTH - 1 - i] = board_index(board, cell);
+            board_occupy(board, cell);
+            cell = step_cell(cell, back);
+        }
+
+        arena->heads[snake] = head;
+        arena->directions[snake] = direction;
+        arena->moved[snake] = direction;
+        arena->lengths[snake] = ARENA_SNAKE_LENGTH;
+        arena->alive[snake] = 1;
+        arena->alive_count++;
+        if (snake < arena->player_count) {
+            arena->alive_players++;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Puts an apple on a random cell that holds neither a snake nor another apple.
+ *
+ * @return true if the apple was placed, false if it has to wait for a later tick.
+ */
+static bool spawn_arena_apple(Arena *arena, int apple) {
+    Board *board = &arena->board;
+
+    arena->apples[apple] = -1;
+    for (int attempt = 0; attempt < ARENA_SPAWN_ATTEMPTS && board->free_count > 0; attempt++) {
+        int32_t cell = board->free_cells[rng_range(&arena->rng, 0, board->free_count - 1)];
+
+        if (arena->apple_slots[cell] < 0) {
+            arena->apple_slots[cell] = (int16_t) apple;
+            arena->apples[apple] = cell;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Doubles a snake's ring buffer, unrolling it so the tail ends up in slot 0.
+ *
+ * @return true if the buffer was grown, false if the allocation failed.
+ */
+static bool grow_arena_body(Arena *arena, int snake) {
+    int length = arena->lengths[snake];
+    int capacity = (arena->body_masks[snake] + 1) * 2;
+    int32_t *body = malloc(capacity * sizeof(int32_t));
+
+    if (body == NULL) {
+        fprintf(stderr, ARENA_ALLOC_ERROR, arena->snake_count);
+        return false;
+    }
+
+    for (int i = 0; i < length; i++) {
+        body[length - 1 - i] = arena_segment(arena, snake, i);
+    }
+
+    free(arena->bodies[snake]);
+    arena->bodies[snake] = body;
+    arena->body_masks[snake] = capacity - 1;
+    arena->head_slots[snake] = length - 1;
+
+    return true;
+}
+
+/**
+ * @brief Finds the apple nearest to a cell, by Manhattan distance.
+ *
+ * The board is searched in rings of growing distance around the cell, up to arena->ai_sight, so the
+ * cost does not grow with the number of apples; only when none is that close are all apples checked.
+ *
+ * @return The cell of the nearest apple, or the given cell if there is no apple on the board.
+ */
+static Cell nearest_apple(const Arena *arena, Cell from) {
+    const Board *board = &arena->board;
+
+    for (int d = 1; d <= arena->ai_sight; d++) {
+        for (int k = 0; k < d; k++) {
+            Cell ring[] = {{from.x + d - k, from.y + k}, {from.x - k, from.y + d - k},
+                           {from.x - d + k, from.y - k}, {from.x + k, from.y - d + k}};
+
+            for (int i = 0; i < 4; i++) {
+                if (board_contains(board, ring[i]) && arena->apple_slots[board_index(board, ring[i])] >= 0) {
+                    return ring[i];
+                }
+            }
+        }
+    }
+
+    Cell target = from;
+    int nearest = -1;
+    for (int i = 0; i < arena->apple_count; i++) {
+        if (arena->apples[i] < 0) {
+            continue;
+        }
+
+        Cell apple = board_cell(board, arena->apples[i]);
+        int distance = abs(apple.x - from.x) + abs(apple.y - from.y);
+        if (nearest < 0 || distance < nearest) {
+            nearest = distance;
+            target = apple;
+        }
+    }
+
+    return target;
+}
+
+/**
+ * @brief Picks the direction of an AI snake.
+ *
+ * The snake goes straight, left or right, whichever safe cell gets it closest to the nearest
+ * apple, and keeps going straight on a tie. It only looks one cell ahead.
+ */
+static void steer_ai(Arena *arena, int snake) {
+    const Board *board = &arena->board;
+    Cell head = arena->heads[snake];
+    Cell target = nearest_apple(arena, head);
+
+    Dir current = arena->directions[snake];
+    Dir options[] = {current, DIR_TURN_LEFT[current], DIR_TURN_RIGHT[current]};
+    int best = -1;
+
+    for (int i = 0; i < 3; i++) {
+        Cell cell = step_cell(head, options[i]);
+        if (!board_cell_free(board, cell)) {
+            continue;
+        }
+
+        int distance = abs(target.x - cell.x) + abs(target.y - cell.y);
+        if (best < 0 || distance < best) {
+            best = distance;
+            arena->directions[snake] = options[i];
+        }
+    }
+}
+
+/**
+ * @brief Sets up an arena and places its snakes and apples.
+ *
+ * An arena that was already initialized is released first, so this can be used to restart.
+ * Snakes that find no room on the board start the game dead.
+ *
+ * @param arena A pointer to the Arena struct to initialize; zero it before the first call.
+ * @param cols The number of columns, between BOARD_MIN_SIZE and BOARD_MAX_SIZE.
+ * @param rows The number of rows, between BOARD_MIN_SIZE and BOARD_MAX_SIZE.
+ * @param snakes The number of snakes, between 1 and ARENA_MAX_SNAKES.
+ * @param players How many of the snakes are steered by players, the rest is steered by the AI.
+ * @param apples The number of apples on the board at once, between 1 and ARENA_MAX_APPLES.
+ * @param seed The seed of the arena's random number generator.
+ *
+ * @return true on success, false if a parameter is out of range or memory ran out.
+ */
+bool init_arena(Arena *arena, int cols, int rows, int snakes, int players, int apples, uint64_t seed) {
+    free_arena(arena);
+
+    if (snakes < 1 || snakes > ARENA_MAX_SNAKES || players < 0 || players > snakes ||
+        apples < 1 || apples > ARENA_MAX_APPLES) {
+        fprintf(stderr, ARENA_SETUP_ERROR, ARENA_MAX_SNAKES, ARENA_MAX_APPLES);
+        return false;
+    }
+
+    if (!init_board(&arena->board, cols, rows)) {
+        return false;
+    }
+
+    size_t words = (arena->board.cells + 63) / 64;
+    arena->apple_slots = malloc(arena->board.cells * sizeof(int16_t));
+    arena->claimed = calloc(words, sizeof(uint64_t));
+    arena->contested = calloc(words, sizeof(uint64_t));
+    arena->apples = malloc(apples * sizeof(int32_t));
+    arena->heads = malloc(snakes * sizeof(Cell));
+    arena->next = malloc(snakes * sizeof(Cell));
+    arena->directions = malloc(snakes * sizeof(Dir));
+    arena->moved = malloc(snakes * sizeof(Dir));
+    arena->lengths = calloc(snakes, sizeof(int32_t));
+    arena->scores = calloc(snakes, sizeof(int32_t));
+    arena->alive = calloc(snakes, sizeof(uint8_t));
+    arena->fates = calloc(snakes, sizeof(uint8_t));
+    arena->bodies = calloc(snakes, sizeof(int32_t *));
+    arena->body_masks = malloc(snakes * sizeof(int32_t));
+    arena->head_slots = calloc(snakes, sizeof(int32_t));
+
+    bool ok = arena->apple_slots != NULL && arena->claimed != NULL && arena->contested != NULL &&
+              arena->apples != NULL && arena->heads != NULL && arena->next != NULL &&
+              arena->directions != NULL && arena->moved != NULL && arena->lengths != NULL &&
+              arena->scores != NULL && arena->alive != NULL && arena->fates != NULL &&
+              arena->bodies != NULL && arena->body_masks != NULL && arena->head_slots != NULL;
+
+    if (ok) {
+        arena->snake_count = snakes;
+        for (int i = 0; i < snakes && ok; i++) {
+            arena->bodies[i] = malloc(ARENA_BODY_INITIAL_CAPACITY * sizeof(int32_t));
+            arena->body_masks[i] = ARENA_BODY_INITIAL_CAPACITY - 1;
+            ok = arena->bodies[i] != NULL;
+        }
+    }
+
+    if (!ok) {
+        fprintf(stderr, ARENA_ALLOC_ERROR, snakes);
+        free_arena(arena);
+        return false;
+    }
+
+    arena->player_count = players;
+    arena->apple_count = apples;
+    rng_seed(&arena->rng, seed);
+
+    // The rings up to distance d hold 2d(d + 1) cells; searching more cells than there are apples
+    // is slower than checking every apple
+    arena->ai_sight = ARENA_AI_SIGHT;
+    while (arena->ai_sight > 0 && 2 * arena->ai_sight * (arena->ai_sight + 1) > apples) {
+        arena->ai_sight--;
+    }
+
+    // All bytes set gives -1 in every slot
+    memset(arena->apple_slots, 0xFF, arena->board.cells * sizeof(int16_t));
+
+    for (int i = 0; i < snakes; i++) {
+        spawn_snake(arena, i);
+    }
+    for (int i = 0; i < apples; i++) {
+        spawn_arena_apple(arena, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Releases the memory owned by an arena.
+ *
+ * @param arena A pointer to the Arena struct to release.
+ */
+void free_arena(Arena *arena) {
+    if (arena->bodies != NULL) {
+        for (int i = 0; i < arena->snake_count; i++) {
+            free(arena->bodies[i]);
+        }
+    }
+
+    free_board(&arena->board);
+    free(arena->apple_slots);
+    free(arena->claimed);
+    free(arena->contested);
+    free(arena->apples);
+    free(arena->heads);
+    free(arena->next);
+    free(arena->directions);
+    free(arena->moved);
+    free(arena->lengths);
+    free(arena->scores);
+    free(arena->alive);
+    free(arena->fates);
+    free(arena->bodies);
+    free(arena->body_masks);
+    free(arena->head_slots);
+    memset(arena, 0, sizeof(*arena));
+}
+
+/**
+ * @brief Turns a player's snake, unless that would reverse it onto its own body.
+ *
+ * The turn is checked against the direction of the snake's last move, not against a turn made
+ * earlier in the same tick, so two quick turns cannot add up to a reversal.
+ *
+ * @param arena A pointer to the Arena struct.
+ * @param snake The index of the snake to steer.
+ * @param direction The new direction.
+ */
+void steer_arena_snake(Arena *arena, int snake, Dir direction) {
+    if (snake < 0 || snake >= arena->snake_count || !arena->alive[snake]) {
+        return;
+    }
+
+    if (direction != DIR_REVERSE[arena->moved[snake]]) {
+        arena->directions[snake] = direction;
+    }
+}
+
+/**
+ * @brief Advances every snake in the arena by one tick.
+ *
+ * All snakes move at once. Tails leave their cells before heads arrive, as in the single-player
+ * rules, so a snake may follow any tail that is not growing this tick. A snake dies when its head
+ * leaves the board, enters a cell covered by a body, or enters the same cell as another head;
+ * the snakes a dying snake would have hit still move. Dead snakes leave the board at once.
+ * Eaten apples come back on free cells at the end of the tick.
+ *
+ * @param arena A pointer to the Arena struct to advance.
+ *
+ * @return A combination of GameEvent flags: GAME_EVENT_ATE_APPLE if any snake ate,
+ *         GAME_EVENT_DIED if any snake died.
+ */
+int tick_arena(Arena *arena) {
+    Board *board = &arena->board;
+    const int cols = board->cols;
+    const int rows = board->rows;
+    const int snakes = arena->snake_count;
+    int events = GAME_EVENT_NONE;
+
+    arena->ticks++;
+
+    for (int i = arena->player_count; i < snakes; i++) {
+        if (arena->alive[i]) {
+            steer_ai(arena, i);
+        }
+    }
+
+    // Where every head goes; tails that follow leave their cells right away
+    for (int i = 0; i < snakes; i++) {
+        if (!arena->alive[i]) {
+            arena->fates[i] = FATE_IDLE;
+            continue;
+        }
+
+        Cell next = step_cell(arena->heads[i], arena->directions[i]);
+        arena->next[i] = next;
+
+        if (!cell_in_bounds(next, cols, rows)) {
+            arena->fates[i] = FATE_DIES;
+            continue;
+        }
+
+        int c = cell_index(next, cols);
+        arena->fates[i] = arena->apple_slots[c] >= 0 ? FATE_GROWS : FATE_MOVES;
+
+        if (arena->fates[i] == FATE_MOVES) {
+            board_release_at(board, arena_segment(arena, i, arena->lengths[i] - 1));
+        }
+
+        if (bit_test(arena->claimed, c)) {
+            bit_set(arena->contested, c);
+        } else {
+            bit_set(arena->claimed, c);
+        }
+    }
+
+    // Heads that run into a body or into each other
+    for (int i = 0; i < snakes; i++) {
+        if (arena->fates[i] == FATE_MOVES || arena->fates[i] == FATE_GROWS) {
+            int c = cell_index(arena->next[i], cols);
+
+            if (board_occupied_at(board, c) || bit_test(arena->contested, c)) {
+                arena->fates[i] = FATE_DIES;
+            }
+        }
+    }
+
+    // Dead snakes leave the board before the others move in, so no cell is released twice
+    for (int i = 0; i < snakes; i++) {
+        if (arena->fates[i] == FATE_IDLE) {
+            continue;
+        }
+
+        if (cell_in_bounds(arena->next[i], cols, rows)) {
+            int c = cell_index(arena->next[i], cols);
+            bit_clear(arena->claimed, c);
+            bit_clear(arena->contested, c);
+        }
+
+        if (arena->fates[i] == FATE_DIES) {
+            for (int s = 0; s < arena->lengths[i]; s++) {
+                board_release_at(board, arena_segment(arena, i, s));
+            }
+
+            arena->alive[i] = 0;
+            arena->alive_count--;
+            if (i < arena->player_count) {
+                arena->alive_players--;
+            }
+            events |= GAME_EVENT_DIED;
+        }
+    }
+
+    for (int i = 0; i < snakes; i++) {
+        int fate = arena->fates[i];
+        if (fate != FATE_MOVES && fate != FATE_GROWS) {
+            continue;
+        }
+
+        int c = cell_index(arena->next[i], cols);
+
+        if (fate == FATE_GROWS && arena->lengths[i] == arena->body_masks[i] + 1 && !grow_arena_body(arena, i)) {
+            // Out of memory: the snake eats but does not grow
+            board_release_at(board, arena_segment(arena, i, arena->lengths[i] - 1));
+            arena->lengths[i]--;
+        }
+
+        arena->head_slots[i] = (arena->head_slots[i] + 1) & arena->body_masks[i];
+        arena->bodies[i][arena->head_slots[i]] = c;
+        arena->heads[i] = arena->next[i];
+        arena->moved[i] = arena->directions[i];
+        board_occupy_at(board, c);
+
+        if (fate == FATE_GROWS) {
+            arena->lengths[i]++;
+            arena->scores[i]++;
+            arena->apples[arena->apple_slots[c]] = -1;
+            arena->apple_slots[c] = -1;
+            events |= GAME_EVENT_ATE_APPLE;
+        }
+    }
+
+    for (int a = 0; a < arena->apple_count; a++) {
+        if (arena->apples[a] < 0) {
+            spawn_arena_apple(arena, a);
+        }
+    }
+
+    return events;
+}
@@ -0,0 +1,112 @@
+#include "../include//arena_mode.h"
+#include "raylib.h"
+#include "../include//controllers.h"
+#include "../include//render.h"
+#include "../include//window.h"
+
+/**
+ * @brief Steers the player snakes: the first one with the arrow keys, the second one with WASD.
+ *
+ * @param arena A pointer to the Arena struct holding the snakes.
+ */
+static void handle_arena_keys(Arena *arena) {
+    static const int keys[2][4] = {
+            {[LEFT] = KEY_LEFT, [RIGHT] = KEY_RIGHT, [UP] = KEY_UP, [DOWN] = KEY_DOWN},
+            {[LEFT] = KEY_A, [RIGHT] = KEY_D, [UP] = KEY_W, [DOWN] = KEY_S},
+    };
+
+    for (int player = 0; player < arena->player_count && player < ARENA_MAX_PLAYERS; player++) {
+        for (Dir direction = LEFT; direction <= DOWN; direction++) {
+            if (IsKeyPressed(keys[player][direction])) {
+                steer_arena_snake(arena, player, direction);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the snake the camera follows: the first player still alive, or any snake still alive.
+ */
+static int followed_snake(const Arena *arena) {
+    for (int i = 0; i < arena->snake_count; i++) {
+        if (arena->alive[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Runs the multi-snake mode until the window is closed.
+ *
+ * The arena is simulated on the same fixed timestep as the single-player game. The round is over
+ * when every player snake is dead, or, with no players, when every snake is dead; enter starts a
+ * new round on the same board.
+ *
+ * @param arena A pointer to the initialized Arena struct to play.
+ * @param assets A pointer to the Assets struct holding the apple texture and the eating sound.
+ * @param tick_rate Simulation ticks (snake moves) per second.
+ *
+ * @return This function does not return any value.
+ */
+void run_arena(Arena *arena, Assets *assets, int tick_rate) {
+    const double interval = 1.0 / tick_rate;
+    double accumulator = 0.0;
+    Cell camera_target = {arena->board.cols / 2, arena->board.rows / 2};
+
+    while (!WindowShouldClose()) {
+        bool over = arena->player_count > 0 ? arena->alive_players == 0 : arena->alive_count == 0;
+
+        double frame_time = GetFrameTime();
+        if (frame_time > MAX_FRAME_TIME)
+            frame_time = MAX_FRAME_TIME;
+
+        if (!over) {
+            handle_arena_keys(arena);
+            accumulator += frame_time;
+
+            while (accumulator >= interval) {
+                accumulator -= interval;
+
+                queue_sounds(assets, tick_arena(arena));
+            }
+        } else if (IsKeyPressed(KEY_ENTER)) {
+            init_arena(arena, arena->board.cols, arena->board.rows, arena->snake_count,
+                       arena->player_count, arena->apple_count, rng_next(&arena->rng));
+            accumulator = 0.0;
+        }
+
+        int followed = followed_snake(arena);
+        if (followed >= 0) {
+            camera_target = arena->heads[followed];
+        }
+
+        poll_assets(assets);
+
+        handle_zoom();
+        update_camera(camera_target, camera_target, 1.0f);
+
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+
+        begin_board_view();
+        draw_grid();
+        draw_arena_snakes(arena);
+        draw_arena_apples(arena, assets->apple_texture);
+        end_board_view();
+
+        for (int i = 0; i < arena->player_count; i++) {
+            DrawText(TextFormat("Player %d: %d%s", i + 1, arena->scores[i], arena->alive[i] ? "" : " (dead)"),
+                     ARENA_HUD_POSX, ARENA_HUD_POSY + i * 30, ARENA_HUD_FONTSIZE, BLACK);
+        }
+        DrawText(TextFormat("Snakes alive: %d / %d", arena->alive_count, arena->snake_count),
+                 ARENA_HUD_POSX, ARENA_HUD_POSY + arena->player_count * 30, ARENA_HUD_FONTSIZE, BLACK);
+
+        if (over) {
+            DrawText(RESTART_MSG, HALF_SCREEN_W - MeasureText(RESTART_MSG, FONT_SIZE) / 2.0,
+                     HALF_SCREEN_H - 35, FONT_SIZE, RED);
+        }
+
+        EndDrawing();
+    }
+}
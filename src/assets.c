@@ -0,0 +1,198 @@
+#include "../include//assets.h"
+#include "../include//clock.h"
+#include "../include//game.h"
+#include <stdio.h>
+
+#define ASSETS_THREAD_WARNING "WARNING: Could not start the asset loader thread, loading assets synchronously\n"
+
+#ifndef SNAKE_NO_AUDIO
+
+/**
+ * @brief Plays the sounds of the queued events, until the queue is empty.
+ *
+ * Each eating sound goes to the next voice in turn, so it plays over the previous ones; with
+ * EATING_VOICES voices, only a sound that started that many apples ago is cut off.
+ */
+static void dispatch_sounds(Assets *assets) {
+    int events;
+
+    while (pop_audio_event(&assets->events, &events)) {
+        if (events & GAME_EVENT_ATE_APPLE) {
+            PlaySound(assets->eating_voices[assets->next_voice]);
+            assets->next_voice = (assets->next_voice + 1) % EATING_VOICES;
+        }
+    }
+}
+
+/**
+ * @brief Brings up the audio device and loads the sounds and their voices.
+ */
+static void load_sounds(Assets *assets) {
+    Wave eating_wave = LoadWaveFromMemory(".wav", apple_wav, (int) apple_wav_size);
+
+    InitAudioDevice();
+    assets->eating_sound = LoadSoundFromWave(eating_wave);
+    UnloadWave(eating_wave);
+
+    // Aliases share the sound's samples and only add a playback position and a volume each
+    for (int i = 0; i < EATING_VOICES; i++) {
+        assets->eating_voices[i] = LoadSoundAlias(assets->eating_sound);
+        SetSoundVolume(assets->eating_voices[i], APPLE_SOUND_VOLUME);
+    }
+    assets->next_voice = 0;
+
+    atomic_store_explicit(&assets->audio_ready, true, memory_order_release);
+}
+
+#endif
+
+/**
+ * @brief Decodes the embedded assets and brings up the audio device.
+ *
+ * Nothing here touches the GPU: the decoded image is handed over to the main thread, which owns
+ * the OpenGL context.
+ */
+static void load_assets(Assets *assets) {
+    assets->apple_image = LoadImageFromMemory(".png", apple_png, (int) apple_png_size);
+    atomic_store_explicit(&assets->image_ready, true, memory_order_release);
+
+#ifndef SNAKE_NO_AUDIO
+    load_sounds(assets);
+#endif
+}
+
+/**
+ * @brief Runs on the loader thread: loads the assets, then dispatches the queued sounds until
+ * unload_assets() stops it.
+ *
+ * @param arg A pointer to the Assets struct being loaded.
+ *
+ * @return Always NULL.
+ */
+static void *run_loader(void *arg) {
+    Assets *assets = arg;
+
+    load_assets(assets);
+
+#ifndef SNAKE_NO_AUDIO
+    while (!atomic_load_explicit(&assets->stop_audio, memory_order_acquire)) {
+        dispatch_sounds(assets);
+        clock_sleep(AUDIO_POLL_INTERVAL);
+    }
+#endif
+
+    return NULL;
+}
+
+/**
+ * @brief Starts decoding the embedded assets and initializing audio in the background.
+ *
+ * Call this as early as possible; the window can be created while the loader thread runs.
+ * If the thread cannot be started, the assets are loaded synchronously instead, and the queued
+ * sounds are played by poll_assets().
+ *
+ * @param assets A pointer to the Assets struct to fill in.
+ */
+void start_loading_assets(Assets *assets) {
+    assets->apple_texture = (Texture2D) {0};
+    atomic_init(&assets->image_ready, false);
+    atomic_init(&assets->audio_ready, false);
+#ifndef SNAKE_NO_AUDIO
+    init_audio_queue(&assets->events);
+    atomic_init(&assets->stop_audio, false);
+#endif
+
+    assets->loader_started = pthread_create(&assets->loader, NULL, run_loader, assets) == 0;
+
+    if (!assets->loader_started) {
+        fprintf(stderr, ASSETS_THREAD_WARNING);
+        load_assets(assets);
+    }
+}
+
+/**
+ * @brief Uploads the apple texture once its image has been decoded.
+ *
+ * Must be called from the thread that owns the window, typically once per frame. Without a loader
+ * thread, it also plays the sounds queued since the last call.
+ *
+ * @param assets A pointer to the Assets struct being loaded.
+ */
+void poll_assets(Assets *assets) {
+#ifndef SNAKE_NO_AUDIO
+    if (!assets->loader_started) {
+        dispatch_sounds(assets);
+    }
+#endif
+
+    if (assets->apple_texture.id != 0 ||
+        !atomic_load_explicit(&assets->image_ready, memory_order_acquire)) {
+        return;
+    }
+
+    assets->apple_texture = LoadTextureFromImage(assets->apple_image);
+    UnloadImage(assets->apple_image);
+}
+
+/**
+ * @brief Checks whether the audio device is up and the sounds are loaded.
+ *
+ * @param assets A pointer to the Assets struct.
+ *
+ * @return true if sounds can be played; always false with SNAKE_NO_AUDIO.
+ */
+bool assets_audio_ready(const Assets *assets) {
+    return atomic_load_explicit(&assets->audio_ready, memory_order_acquire);
+}
+
+#ifndef SNAKE_NO_AUDIO
+
+/**
+ * @brief Queues the sounds for the events reported by a simulation tick.
+ *
+ * Returns right away: the sounds are played by the dispatcher. Events are dropped while the audio
+ * device is not ready, and when the dispatcher is so far behind that the queue is full.
+ * Must only be called from the thread that runs the simulation.
+ *
+ * @param assets A pointer to the Assets struct.
+ * @param events A combination of GameEvent flags.
+ */
+void queue_sounds(Assets *assets, int events) {
+    if ((events & GAME_EVENT_ATE_APPLE) && assets_audio_ready(assets)) {
+        push_audio_event(&assets->events, events);
+    }
+}
+
+#endif
+
+/**
+ * @brief Stops the dispatcher and releases every asset and the audio device.
+ *
+ * Must be called before the window is closed.
+ *
+ * @param assets A pointer to the Assets struct to release.
+ */
+void unload_assets(Assets *assets) {
+    if (assets->loader_started) {
+#ifndef SNAKE_NO_AUDIO
+        atomic_store_explicit(&assets->stop_audio, true, memory_order_release);
+#endif
+        pthread_join(assets->loader, NULL);
+        assets->loader_started = false;
+    }
+
+    // The image may never have been uploaded if the game was closed right away
+    if (assets->apple_texture.id == 0) {
+        UnloadImage(assets->apple_image);
+    } else {
+        UnloadTexture(assets->apple_texture);
+    }
+
+#ifndef SNAKE_NO_AUDIO
+    for (int i = 0; i < EATING_VOICES; i++) {
+        UnloadSoundAlias(assets->eating_voices[i]);
+    }
+    UnloadSound(assets->eating_sound);
+    CloseAudioDevice();
+#endif
+}
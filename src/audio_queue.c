@@ -0,0 +1,58 @@
+#include "../include//audio_queue.h"
+
+/**
+ * @brief Empties a queue. Must not be called while another thread uses it.
+ *
+ * @param queue A pointer to the AudioQueue to initialize.
+ */
+void init_audio_queue(AudioQueue *queue) {
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->dropped = 0;
+}
+
+/**
+ * @brief Pushes the events of a simulation tick. Called by the producer only.
+ *
+ * @param queue A pointer to the AudioQueue.
+ * @param events A combination of GameEvent flags; a tick without events pushes nothing.
+ *
+ * @return false if the queue was full and the events were dropped.
+ */
+bool push_audio_event(AudioQueue *queue, int events) {
+    if (events == 0) {
+        return true;
+    }
+
+    // Indices only grow and wrap around as unsigned, so tail - head is the number of queued events
+    unsigned tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (tail - head >= AUDIO_QUEUE_SIZE) {
+        queue->dropped++;
+        return false;
+    }
+
+    queue->events[tail & (AUDIO_QUEUE_SIZE - 1)] = (uint8_t) events;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Pops the oldest events. Called by the consumer only.
+ *
+ * @param queue A pointer to the AudioQueue.
+ * @param events Set to the GameEvent flags of the oldest tick queued.
+ *
+ * @return false if the queue is empty.
+ */
+bool pop_audio_event(AudioQueue *queue, int *events) {
+    unsigned head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+
+    *events = queue->events[head & (AUDIO_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return true;
+}
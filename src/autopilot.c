@@ -0,0 +1,372 @@
+#include "../include//autopilot.h"
+#include "../include//clock.h"
+#include "../include//hamilton.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AUTOPILOT_ALLOC_ERROR "ERROR: Out of memory while allocating the autopilot for a %dx%d board\n"
+#define NO_CELL (-1)
+
+static const Dir DIR_REVERSE[] = {[LEFT] = RIGHT, [RIGHT] = LEFT, [UP] = DOWN, [DOWN] = UP};
+static const Dir DIR_TURN_LEFT[] = {[LEFT] = DOWN, [RIGHT] = UP, [UP] = LEFT, [DOWN] = RIGHT};
+static const Dir DIR_TURN_RIGHT[] = {[LEFT] = UP, [RIGHT] = DOWN, [UP] = RIGHT, [DOWN] = LEFT};
+
+/**
+ * @brief Which cells a search may go through.
+ */
+typedef enum {
+    SEARCH_TIMED,    // Free cells, and body cells the snake will have left when the head gets there.
+    SEARCH_VIRTUAL,  // Cells left free once the snake has followed the marked path and grown.
+} SearchMode;
+
+/**
+ * @brief What a search needs to know about the board besides the game.
+ */
+typedef struct {
+    SearchMode mode;
+    int moves_before;    // SEARCH_TIMED: moves the snake makes before the search starts.
+    int path_length;     // SEARCH_VIRTUAL: length of the marked path.
+    int length;          // SEARCH_VIRTUAL: length of the snake before it follows the path.
+    uint32_t path_mark;  // SEARCH_VIRTUAL: mark of the path's cells.
+} SearchRules;
+
+/**
+ * @brief Allocates the search buffers for a board of the given size.
+ *
+ * An autopilot already initialized for the same board size keeps its buffers and its cycle,
+ * one initialized for another size is released first.
+ *
+ * @param autopilot A pointer to the Autopilot struct to initialize; zero it before the first call.
+ * @param cols The number of columns of the board.
+ * @param rows The number of rows of the board.
+ *
+ * @return false if memory ran out.
+ */
+bool init_autopilot(Autopilot *autopilot, int cols, int rows) {
+    if (autopilot->queue != NULL && autopilot->cols == cols && autopilot->rows == rows) {
+        return true;
+    }
+    free_autopilot(autopilot);
+
+    size_t cells = (size_t) cols * rows;
+    autopilot->queue = malloc(cells * sizeof(int32_t));
+    autopilot->visited = calloc(cells, sizeof(uint32_t));
+    autopilot->parent = malloc(cells * sizeof(int32_t));
+    autopilot->free_after = malloc(cells * sizeof(int32_t));
+    autopilot->path_mark = calloc(cells, sizeof(uint32_t));
+    autopilot->path_step = malloc(cells * sizeof(int32_t));
+    autopilot->cycle = has_hamilton_cycle(cols, rows) ? malloc(cells * sizeof(int32_t)) : NULL;
+
+    if (autopilot->queue == NULL || autopilot->visited == NULL || autopilot->parent == NULL ||
+        autopilot->free_after == NULL || autopilot->path_mark == NULL || autopilot->path_step == NULL ||
+        (autopilot->cycle == NULL && has_hamilton_cycle(cols, rows))) {
+        fprintf(stderr, AUTOPILOT_ALLOC_ERROR, cols, rows);
+        free_autopilot(autopilot);
+        return false;
+    }
+
+    if (autopilot->cycle != NULL) {
+        build_hamilton_cycle(autopilot->cycle, cols, rows);
+    }
+    autopilot->cycle_next = -1;
+    autopilot->cols = cols;
+    autopilot->rows = rows;
+
+    return true;
+}
+
+/**
+ * @brief Releases the search buffers of an autopilot.
+ *
+ * @param autopilot A pointer to the Autopilot struct to release.
+ */
+void free_autopilot(Autopilot *autopilot) {
+    free(autopilot->queue);
+    free(autopilot->visited);
+    free(autopilot->parent);
+    free(autopilot->free_after);
+    free(autopilot->path_mark);
+    free(autopilot->path_step);
+    free(autopilot->cycle);
+    memset(autopilot, 0, sizeof(*autopilot));
+}
+
+/**
+ * @brief Starts a new search, so every cell counts as not visited.
+ */
+static uint32_t next_search(Autopilot *autopilot) {
+    if (++autopilot->search == 0) {
+        // The stamps wrapped around, once every four billion searches
+        size_t cells = (size_t) autopilot->cols * autopilot->rows;
+        memset(autopilot->visited, 0, cells * sizeof(uint32_t));
+        memset(autopilot->path_mark, 0, cells * sizeof(uint32_t));
+        autopilot->search = 1;
+    }
+    return autopilot->search;
+}
+
+/**
+ * @brief Returns the neighbour of a cell in the given direction.
+ */
+static Cell step_cell(Cell cell, Dir direction) {
+    switch (direction) {
+        case LEFT:
+            cell.x -= 1;
+            break;
+        case RIGHT:
+            cell.x += 1;
+            break;
+        case UP:
+            cell.y -= 1;
+            break;
+        case DOWN:
+            cell.y += 1;
+            break;
+    }
+    return cell;
+}
+
+/**
+ * @brief Records how many moves it takes each body segment to leave its cell.
+ *
+ * The tail leaves on the next move, the segment before it on the move after, and so on, as long
+ * as the snake does not grow.
+ */
+static void time_body(Autopilot *autopilot, const Game *game) {
+    const Snake *snake = &game->snake;
+
+    for (int i = 0; i < snake->length; i++) {
+        autopilot->free_after[board_index(&game->board, snake_segment(snake, i))] = snake->length - i;
+    }
+}
+
+/**
+ * @brief Checks whether a search may enter a cell, the given number of moves after the search started.
+ */
+static inline bool can_enter(const Autopilot *autopilot, const Board *board, const SearchRules *rules, int cell,
+                             int moves) {
+    if (rules->mode == SEARCH_VIRTUAL) {
+        // Path cells are covered by the grown snake's last length + 1 moves, old body cells by what
+        // is left after path_length - 1 ordinary moves (the last move grows instead)
+        if (autopilot->path_mark[cell] == rules->path_mark) {
+            return autopilot->path_step[cell] <= rules->path_length - (rules->length + 1);
+        }
+        return !board_occupied_at(board, cell) || autopilot->free_after[cell] <= rules->path_length - 1;
+    }
+
+    return !board_occupied_at(board, cell) || autopilot->free_after[cell] <= rules->moves_before + moves;
+}
+
+/**
+ * @brief Finds a shortest path between two cells, breadth first.
+ *
+ * Reached cells get their parent set, so the path can be walked back from the target.
+ *
+ * @param autopilot A pointer to the Autopilot holding the search buffers; time_body() must have
+ *                  been called for the current state.
+ * @param game A pointer to the game to search.
+ * @param start The cell index the path starts from; it may be occupied.
+ * @param target The cell index the path goes to; it may be occupied.
+ * @param forbidden A cell index the first move may not go to, or NO_CELL.
+ * @param rules Which cells the path may go through.
+ *
+ * @return The number of moves of the path, or -1 if there is none.
+ */
+static int search_path(Autopilot *autopilot, const Game *game, int start, int target, int forbidden,
+                       const SearchRules *rules) {
+    const Board *board = &game->board;
+    const int cols = board->cols;
+    const uint32_t stamp = next_search(autopilot);
+    int32_t *queue = autopilot->queue;
+    uint32_t *visited = autopilot->visited;
+    int32_t *parent = autopilot->parent;
+    int head = 0;
+    int count = 0;
+    int layer_end = 1;  // End of the queued cells at the current distance
+    int distance = 0;
+
+    visited[start] = stamp;
+    queue[count++] = start;
+
+    while (head < count) {
+        if (head == layer_end) {
+            layer_end = count;
+            distance++;
+        }
+
+        int i = queue[head++];
+        int x = i % cols;
+        int neighbours[4] = {
+                [LEFT] = x > 0 ? i - 1 : NO_CELL,
+                [RIGHT] = x < cols - 1 ? i + 1 : NO_CELL,
+                [UP] = i >= cols ? i - cols : NO_CELL,
+                [DOWN] = i < board->cells - cols ? i + cols : NO_CELL,
+        };
+
+        for (int d = 0; d < 4; d++) {
+            int n = neighbours[d];
+            if (n == NO_CELL || visited[n] == stamp || (i == start && n == forbidden)) {
+                continue;
+            }
+            if (n == target) {
+                parent[n] = i;
+                return distance + 1;
+            }
+            if (can_enter(autopilot, board, rules, n, distance + 1)) {
+                visited[n] = stamp;
+                parent[n] = i;
+                queue[count++] = n;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Returns the direction of a move between two neighbouring cells.
+ */
+static Dir direction_between(int from, int to) {
+    if (to == from - 1) {
+        return LEFT;
+    }
+    if (to == from + 1) {
+        return RIGHT;
+    }
+    return to < from ? UP : DOWN;
+}
+
+/**
+ * @brief Checks that the snake could still reach its tail after eating at the end of a path.
+ *
+ * Marks the path just found by search_path(), works out where the tail is once the snake has
+ * followed it and grown, and searches from the apple to that tail around the grown body.
+ *
+ * @param length The number of moves of the path.
+ * @param first Set to the first cell of the path.
+ */
+static bool safe_after_path(Autopilot *autopilot, const Game *game, int start, int apple, int length, int *first) {
+    const Snake *snake = &game->snake;
+    const uint32_t mark = autopilot->search;
+    int tail = NO_CELL;
+
+    // Walk the path back from the apple; the grown snake covers its last snake->length + 1 cells
+    for (int cell = apple, step = length; cell != start; cell = autopilot->parent[cell], step--) {
+        autopilot->path_mark[cell] = mark;
+        autopilot->path_step[cell] = step;
+        if (step == length - snake->length) {
+            tail = cell;
+        }
+        *first = cell;
+    }
+
+    // A path shorter than the snake leaves part of the old body in place, tail included
+    if (length <= snake->length) {
+        tail = board_index(&game->board, snake_segment(snake, snake->length - length));
+    }
+
+    SearchRules rules = {SEARCH_VIRTUAL, 0, length, snake->length, mark};
+    return tail != NO_CELL && search_path(autopilot, game, apple, tail, NO_CELL, &rules) >= 0;
+}
+
+/**
+ * @brief Picks the direction for the next tick.
+ *
+ * Takes the first move of a shortest path to the apple if the snake can still reach its tail once
+ * it has eaten. Otherwise, of the moves after which the tail can be reached, takes the one
+ * farthest from the tail: the long way round straightens the body and frees room, where the short
+ * way would circle in place. Failing that, takes any move that does not kill the snake next tick,
+ * going straight if there is none.
+ *
+ * This does not always finish a game: near a full board, the apple can stay out of reach for
+ * good, and the snake then chases its tail forever. Only hamilton_decide() is sure to fill the board.
+ *
+ * @param autopilot A pointer to an Autopilot initialized for the game's board size.
+ * @param game A pointer to the game to play.
+ *
+ * @return The direction for the next tick.
+ */
+Dir autopilot_decide(Autopilot *autopilot, const Game *game) {
+    const Board *board = &game->board;
+    const Snake *snake = &game->snake;
+    Cell head = snake_head(snake);
+    Dir current = snake->direction;
+    int start = board_index(board, head);
+    int tail = board_index(board, snake_tail(snake));
+    Cell back = step_cell(head, DIR_REVERSE[current]);
+    int behind = snake->has_moved && board_contains(board, back) ? board_index(board, back) : NO_CELL;
+
+    time_body(autopilot, game);
+
+    if (!game->apple.eaten) {
+        SearchRules rules = {SEARCH_TIMED, 0, 0, 0, 0};
+        int apple = board_index(board, game->apple.pos);
+        int length = search_path(autopilot, game, start, apple, behind, &rules);
+        int first = NO_CELL;
+
+        if (length > 0 && safe_after_path(autopilot, game, start, apple, length, &first)) {
+            return direction_between(start, first);
+        }
+    }
+
+    autopilot->tail_chases++;
+
+    Dir options[] = {current, DIR_TURN_LEFT[current], DIR_TURN_RIGHT[current]};
+    Dir best_direction = current;
+    int best = -2;  // Below the -1 of a move that survives the next tick but loses the tail
+
+    for (int i = 0; i < 3; i++) {
+        Cell next = step_cell(head, options[i]);
+        if (!board_contains(board, next)) {
+            continue;
+        }
+
+        int cell = board_index(board, next);
+        bool eats = !game->apple.eaten && next.x == game->apple.pos.x && next.y == game->apple.pos.y;
+        if (board_occupied_at(board, cell) && (cell != tail || eats || snake->length == 1)) {
+            continue;
+        }
+
+        SearchRules rules = {SEARCH_TIMED, eats ? 0 : 1, 0, 0, 0};
+        int distance = cell == tail ? 0 : search_path(autopilot, game, cell, tail, NO_CELL, &rules);
+        if (distance > best) {
+            best = distance;
+            best_direction = options[i];
+        }
+    }
+
+    return best_direction;
+}
+
+/**
+ * @brief Lets the autopilot steer the snake for the next tick, and times the decision.
+ *
+ * @param autopilot A pointer to an Autopilot initialized for the game's board size.
+ * @param game A pointer to the game to steer.
+ */
+void steer_autopilot(Autopilot *autopilot, Game *game) {
+    double start = clock_now();
+    Dir direction = autopilot_decide(autopilot, game);
+    double elapsed = clock_now() - start;
+
+    game->snake.direction = direction;
+    game->snake.has_moved = true;
+
+    autopilot->decisions++;
+    autopilot->total_time += elapsed;
+    if (elapsed > autopilot->max_time) {
+        autopilot->max_time = elapsed;
+    }
+}
+
+/**
+ * @brief Returns the average time the autopilot took per decision, in seconds.
+ *
+ * @param autopilot A pointer to the Autopilot.
+ *
+ * @return The average decision time, or 0 if there were no decisions.
+ */
+double average_autopilot_latency(const Autopilot *autopilot) {
+    return autopilot->decisions > 0 ? autopilot->total_time / autopilot->decisions : 0.0;
+}
@@ -0,0 +1,521 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include//clock.h"
+#include "../include//framebuffer.h"
+#include "../include//game.h"
+#include "../include//hamilton.h"
+#include "../include//leaderboard.h"
+#include "../include//policy.h"
+#include "../include//render_backend.h"
+#include "../include//window.h"
+
+#define USAGE_MSG "Usage: %s [--sizes COLSxROWS,...] [--repeat N] [--format json|csv] [--output FILE]\n"
+#define BENCH_ALLOC_ERROR "ERROR: Out of memory while setting up the %s benchmark on a %dx%d board\n"
+#define BENCH_OUTPUT_ERROR "ERROR: Could not write %s\n"
+#define BENCH_SKIP_WARNING "WARNING: Skipping the %s benchmark on a %dx%d board, %s\n"
+
+#define DEFAULT_BENCH_SIZES "16x12,32x24,64x48,128x96,256x192"
+#define DEFAULT_BENCH_REPEAT 5
+#define MAX_BENCH_SIZES 16
+#define MAX_BENCH_REPEAT 100
+#define MAX_BENCH_RESULTS (MAX_BENCH_SIZES * 16 + 4)
+#define BENCH_LEADERBOARD_PATH "bench_leaderboard.bin"
+
+#define TICK_OPS 1000000     // Ticks per repeat of the tick benchmarks.
+#define SPAWN_OPS 1000000    // Apples placed per repeat of the spawn benchmark.
+#define LOAD_OPS 20000       // Leaderboard loads per repeat.
+#define SAVE_OPS 50          // Leaderboard saves per repeat; each one syncs the file to disk.
+#define RENDER_OPS 200       // Frames drawn per repeat of the render benchmark.
+#define RENDER_FILL 0.5      // Part of the board the snake covers in the rendered frames.
+
+static const double SPAWN_FILLS[] = {0.0, 0.5, 0.9, 0.99};
+static const double COLLISION_FILLS[] = {0.01, 0.25, 0.5, 0.9};
+
+typedef enum {
+    FORMAT_JSON,
+    FORMAT_CSV,
+} BenchFormat;
+
+/**
+ * @brief The timings of one benchmark on one board.
+ */
+typedef struct {
+    const char *name;
+    int cols;            // Board size, 0 for benchmarks that do not depend on it.
+    int rows;
+    int occupied;        // Cells covered by the snake, or filled before placing apples.
+    long ops;            // Operations timed per repeat.
+    double ns_min;       // Fastest repeat, in nanoseconds per operation.
+    double ns_median;    // Median repeat, in nanoseconds per operation.
+} BenchResult;
+
+/**
+ * @brief The settings of a run and the results collected so far.
+ */
+typedef struct {
+    int sizes[MAX_BENCH_SIZES][2];
+    int size_count;
+    int repeat;
+    BenchFormat format;
+    const char *output;  // NULL for stdout.
+
+    BenchResult results[MAX_BENCH_RESULTS];
+    int result_count;
+} Bench;
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Records a benchmark's result from the duration of each repeat, in seconds.
+ */
+static void add_result(Bench *bench, const char *name, int cols, int rows, int occupied, long ops, double *seconds) {
+    if (bench->result_count >= MAX_BENCH_RESULTS) {
+        return;
+    }
+
+    qsort(seconds, bench->repeat, sizeof(double), compare_doubles);
+
+    BenchResult *result = &bench->results[bench->result_count++];
+    result->name = name;
+    result->cols = cols;
+    result->rows = rows;
+    result->occupied = occupied;
+    result->ops = ops;
+    result->ns_min = seconds[0] * 1e9 / ops;
+    result->ns_median = seconds[bench->repeat / 2] * 1e9 / ops;
+}
+
+/**
+ * @brief Plays whole games with the hamilton policy, starting a new one whenever a game ends.
+ *
+ * Measures the tick rate of a real game, snake growing and apples respawning, with a policy that
+ * costs a fraction of a tick.
+ */
+static void bench_ticks(Bench *bench, int cols, int rows) {
+    Game game = {0};
+    Autopilot search = {0};
+    const Policy *policy = find_policy("hamilton");
+    double seconds[MAX_BENCH_REPEAT];
+
+    game.cols = cols;
+    game.rows = rows;
+    if (!init_game(&game) || !init_autopilot(&search, cols, rows)) {
+        fprintf(stderr, BENCH_ALLOC_ERROR, "ticks", cols, rows);
+        free_game(&game);
+        return;
+    }
+
+    Rng rng;
+    rng_seed(&rng, 1);
+    double dt = tick_interval(&game);
+
+    for (int r = 0; r < bench->repeat; r++) {
+        double start = clock_now();
+        for (long t = 0; t < TICK_OPS; t++) {
+            if (game.state != PLAYING) {
+                game.seed++;
+                init_game(&game);
+            }
+            apply_policy(&game, policy, &rng, &search);
+            tick_game(&game, dt);
+        }
+        seconds[r] = clock_now() - start;
+    }
+
+    add_result(bench, "ticks", cols, rows, 0, TICK_OPS, seconds);
+    free_autopilot(&search);
+    free_game(&game);
+}
+
+/**
+ * @brief Places apples on boards filled to increasing ratios, at random cells.
+ */
+static void bench_apple_spawn(Bench *bench, int cols, int rows) {
+    Board board = {0};
+    double seconds[MAX_BENCH_REPEAT];
+
+    if (!init_board(&board, cols, rows)) {
+        fprintf(stderr, BENCH_ALLOC_ERROR, "apple_spawn", cols, rows);
+        return;
+    }
+
+    for (size_t f = 0; f < sizeof(SPAWN_FILLS) / sizeof(SPAWN_FILLS[0]); f++) {
+        Rng rng;
+        rng_seed(&rng, 1);
+        clear_board(&board);
+
+        // Occupy random cells: picking from the free cells spreads them like a long snake's body
+        int occupied = (int) (SPAWN_FILLS[f] * board.cells);
+        for (int i = 0; i < occupied; i++) {
+            board_occupy_at(&board, board.free_cells[rng_range(&rng, 0, board.free_count - 1)]);
+        }
+
+        Apple apple = {0};
+        Timer timer = {0};
+        long placed = 0;
+        for (int r = 0; r < bench->repeat; r++) {
+            double start = clock_now();
+            for (long i = 0; i < SPAWN_OPS; i++) {
+                placed += init_apple(&apple, &board, &timer, &rng);
+            }
+            seconds[r] = clock_now() - start;
+        }
+
+        // Keeps the placements from being optimized away
+        if (placed == 0 || !board_contains(&board, apple.pos)) {
+            fprintf(stderr, BENCH_SKIP_WARNING, "apple_spawn", cols, rows, "no apple was placed");
+            continue;
+        }
+        add_result(bench, "apple_spawn", cols, rows, occupied, SPAWN_OPS, seconds);
+    }
+
+    free_board(&board);
+}
+
+/**
+ * @brief Moves snakes of increasing length around the board's Hamiltonian cycle, with no apple.
+ *
+ * Every tick checks the head against the body, so this shows whether a tick's cost grows with
+ * the snake's length.
+ */
+static void bench_collision(Bench *bench, int cols, int rows) {
+    if (!has_hamilton_cycle(cols, rows)) {
+        fprintf(stderr, BENCH_SKIP_WARNING, "collision", cols, rows, "it has no Hamiltonian cycle");
+        return;
+    }
+
+    Game game = {0};
+    int cells = cols * rows;
+    int32_t *position = malloc(cells * sizeof(int32_t));
+    int32_t *order = malloc(cells * sizeof(int32_t));
+    Dir *next_direction = malloc(cells * sizeof(Dir));
+    double seconds[MAX_BENCH_REPEAT];
+
+    game.cols = cols;
+    game.rows = rows;
+    if (position == NULL || order == NULL || next_direction == NULL || !init_game(&game)) {
+        fprintf(stderr, BENCH_ALLOC_ERROR, "collision", cols, rows);
+        free(position);
+        free(order);
+        free(next_direction);
+        free_game(&game);
+        return;
+    }
+
+    build_hamilton_cycle(position, cols, rows);
+    for (int i = 0; i < cells; i++) {
+        order[position[i]] = i;
+    }
+    for (int p = 0; p < cells; p++) {
+        int from = order[p];
+        int to = order[(p + 1) % cells];
+        next_direction[from] = to == from - 1 ? LEFT : to == from + 1 ? RIGHT : to < from ? UP : DOWN;
+    }
+
+    for (size_t f = 0; f < sizeof(COLLISION_FILLS) / sizeof(COLLISION_FILLS[0]); f++) {
+        int length = (int) (COLLISION_FILLS[f] * cells);
+        length = length < 3 ? 3 : length;
+
+        // Lay the snake along the start of the cycle, tail first
+        Snake *snake = &game.snake;
+        if (!reserve_snake(snake, length)) {
+            fprintf(stderr, BENCH_ALLOC_ERROR, "collision", cols, rows);
+            break;
+        }
+        clear_board(&game.board);
+        snake->head = 0;
+        snake->length = 1;
+        snake->body[0] = board_cell(&game.board, order[0]);
+        board_occupy_at(&game.board, order[0]);
+        for (int p = 1; p < length; p++) {
+            advance_snake(snake, board_cell(&game.board, order[p]), true);
+            board_occupy_at(&game.board, order[p]);
+        }
+        snake->has_moved = true;
+
+        // Hide the apple for longer than the benchmark runs
+        game.apple.eaten = true;
+        game.apple.first_render = false;
+        start_timer(&game.apple.timer, 1e12);
+        game.state = PLAYING;
+
+        double dt = tick_interval(&game);
+        for (int r = 0; r < bench->repeat; r++) {
+            double start = clock_now();
+            for (long t = 0; t < TICK_OPS; t++) {
+                snake->direction = next_direction[board_index(&game.board, snake_head(snake))];
+                tick_game(&game, dt);
+            }
+            seconds[r] = clock_now() - start;
+        }
+
+        if (game.state != PLAYING) {
+            fprintf(stderr, BENCH_SKIP_WARNING, "collision", cols, rows, "the snake died");
+            continue;
+        }
+        add_result(bench, "collision", cols, rows, length, TICK_OPS, seconds);
+    }
+
+    free(position);
+    free(order);
+    free(next_direction);
+    free_game(&game);
+}
+
+/**
+ * @brief Draws whole frames with the CPU rasterizer: background, grid, a snake covering half the board
+ * and the apple, into a window-sized framebuffer.
+ */
+static void bench_render(Bench *bench, int cols, int rows) {
+    Game game = {0};
+    Autopilot search = {0};
+    Framebuffer frame = {0};
+    Framebuffer apple_sprite = {0};
+    SnakeMesh mesh;
+    const Policy *policy = find_policy("hamilton");
+    double seconds[MAX_BENCH_REPEAT];
+
+    init_snake_mesh(&mesh);
+    game.cols = cols;
+    game.rows = rows;
+    if (!init_game(&game) || !init_autopilot(&search, cols, rows) ||
+        !init_framebuffer(&frame, (int) SCREEN_WIDTH, (int) SCREEN_HEIGHT) ||
+        !build_apple_sprite(&apple_sprite, (int) CELL_SIZE)) {
+        fprintf(stderr, BENCH_ALLOC_ERROR, "render", cols, rows);
+        free_framebuffer(&apple_sprite);
+        free_framebuffer(&frame);
+        free_autopilot(&search);
+        free_game(&game);
+        return;
+    }
+
+    // Grow the snake to a realistic mid-game length first
+    Rng rng;
+    rng_seed(&rng, 1);
+    double dt = tick_interval(&game);
+    int occupied = (int) (RENDER_FILL * cols * rows);
+    while (game.state == PLAYING && game.snake.length < occupied) {
+        apply_policy(&game, policy, &rng, &search);
+        tick_game(&game, dt);
+    }
+
+    rebuild_snake_mesh(&mesh, &game.snake);
+    RenderBackend backend = framebuffer_backend(&frame);
+    RenderView view;
+    fit_render_view(&view, cols, rows, frame.width, frame.height);
+
+    for (int r = 0; r < bench->repeat; r++) {
+        double start = clock_now();
+        for (long i = 0; i < RENDER_OPS; i++) {
+            clear_framebuffer(&frame, RENDER_RAYWHITE);
+            draw_grid_lines(&backend, &view);
+            draw_snake_scene(&backend, &view, &game.snake, &mesh, (float) i / RENDER_OPS);
+            draw_apple_scene(&backend, &view, &game.apple, &apple_sprite);
+        }
+        seconds[r] = clock_now() - start;
+    }
+
+    add_result(bench, "render", cols, rows, game.snake.length, RENDER_OPS, seconds);
+    free_snake_mesh(&mesh);
+    free_framebuffer(&apple_sprite);
+    free_framebuffer(&frame);
+    free_autopilot(&search);
+    free_game(&game);
+}
+
+/**
+ * @brief Loads and saves a full leaderboard file, the score I/O done at startup and after each game.
+ */
+static void bench_score_io(Bench *bench) {
+    Leaderboard leaderboard = {0};
+    double seconds[MAX_BENCH_REPEAT];
+
+    remove(BENCH_LEADERBOARD_PATH);
+    open_leaderboard(&leaderboard, BENCH_LEADERBOARD_PATH);
+
+    // Saves insert ever better scores, so every one of them rewrites the file
+    int score = 0;
+    for (int r = 0; r < bench->repeat; r++) {
+        double start = clock_now();
+        for (long i = 0; i < SAVE_OPS; i++) {
+            LeaderboardEntry entry = {.score = ++score, .length = score + 3, .seed = (uint64_t) score};
+            if (!leaderboard_insert(&leaderboard, BENCH_LEADERBOARD_PATH, &entry)) {
+                fprintf(stderr, BENCH_SKIP_WARNING, "score_save", 0, 0, "the file could not be written");
+                close_leaderboard(&leaderboard);
+                remove(BENCH_LEADERBOARD_PATH);
+                return;
+            }
+        }
+        seconds[r] = clock_now() - start;
+    }
+    add_result(bench, "score_save", 0, 0, 0, SAVE_OPS, seconds);
+    close_leaderboard(&leaderboard);
+
+    int entries = 0;
+    for (int r = 0; r < bench->repeat; r++) {
+        double start = clock_now();
+        for (long i = 0; i < LOAD_OPS; i++) {
+            open_leaderboard(&leaderboard, BENCH_LEADERBOARD_PATH);
+            entries += leaderboard_count(&leaderboard);
+            close_leaderboard(&leaderboard);
+        }
+        seconds[r] = clock_now() - start;
+    }
+    if (entries == 0) {
+        fprintf(stderr, BENCH_SKIP_WARNING, "score_load", 0, 0, "the file could not be read");
+    } else {
+        add_result(bench, "score_load", 0, 0, 0, LOAD_OPS, seconds);
+    }
+
+    remove(BENCH_LEADERBOARD_PATH);
+}
+
+/**
+ * @brief Writes the results as JSON or CSV, one record per benchmark and board.
+ */
+static void write_results(const Bench *bench, FILE *out) {
+    if (bench->format == FORMAT_CSV) {
+        fprintf(out, "name,cols,rows,occupied,fill,ops,ns_min,ns_median,ops_per_sec\n");
+    } else {
+        fprintf(out, "{\n  \"repeat\": %d,\n  \"results\": [\n", bench->repeat);
+    }
+
+    for (int i = 0; i < bench->result_count; i++) {
+        const BenchResult *r = &bench->results[i];
+        int cells = r->cols * r->rows;
+        double fill = cells > 0 ? (double) r->occupied / cells : 0.0;
+        double rate = r->ns_median > 0.0 ? 1e9 / r->ns_median : 0.0;
+
+        if (bench->format == FORMAT_CSV) {
+            fprintf(out, "%s,%d,%d,%d,%.4f,%ld,%.2f,%.2f,%.0f\n",
+                    r->name, r->cols, r->rows, r->occupied, fill, r->ops, r->ns_min, r->ns_median, rate);
+        } else {
+            fprintf(out,
+                    "    {\"name\": \"%s\", \"cols\": %d, \"rows\": %d, \"occupied\": %d, \"fill\": %.4f, "
+                    "\"ops\": %ld, \"ns_min\": %.2f, \"ns_median\": %.2f, \"ops_per_sec\": %.0f}%s\n",
+                    r->name, r->cols, r->rows, r->occupied, fill, r->ops, r->ns_min, r->ns_median, rate,
+                    i + 1 < bench->result_count ? "," : "");
+        }
+    }
+
+    if (bench->format == FORMAT_JSON) {
+        fprintf(out, "  ]\n}\n");
+    }
+}
+
+/**
+ * @brief Parses a comma-separated list of board sizes, such as 32x24,64x48.
+ *
+ * @return false if a size is malformed, out of range or there are too many.
+ */
+static bool parse_sizes(const char *value, Bench *bench) {
+    bench->size_count = 0;
+
+    while (*value != '\0') {
+        int cols, rows, used;
+        if (bench->size_count >= MAX_BENCH_SIZES || sscanf(value, "%dx%d%n", &cols, &rows, &used) != 2 ||
+            cols < BOARD_MIN_SIZE || cols > BOARD_MAX_SIZE || rows < BOARD_MIN_SIZE || rows > BOARD_MAX_SIZE) {
+            return false;
+        }
+
+        bench->sizes[bench->size_count][0] = cols;
+        bench->sizes[bench->size_count][1] = rows;
+        bench->size_count++;
+
+        value += used;
+        if (*value == ',') {
+            value++;
+        } else if (*value != '\0') {
+            return false;
+        }
+    }
+
+    return bench->size_count > 0;
+}
+
+/**
+ * @brief Parses the command line into the benchmark settings.
+ *
+ * @return false if an argument is unknown or malformed.
+ */
+static bool parse_args(int argc, char **argv, Bench *bench) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            return false;
+        }
+
+        const char *value = argv[++i];
+        char *endptr;
+        long number = strtol(value, &endptr, 10);
+        bool numeric = *endptr == '\0' && number >= 0;
+
+        if (strcmp(argv[i - 1], "--sizes") == 0) {
+            if (!parse_sizes(value, bench)) {
+                return false;
+            }
+        } else if (strcmp(argv[i - 1], "--repeat") == 0 && numeric && number > 0 && number <= MAX_BENCH_REPEAT) {
+            bench->repeat = (int) number;
+        } else if (strcmp(argv[i - 1], "--format") == 0 && strcmp(value, "json") == 0) {
+            bench->format = FORMAT_JSON;
+        } else if (strcmp(argv[i - 1], "--format") == 0 && strcmp(value, "csv") == 0) {
+            bench->format = FORMAT_CSV;
+        } else if (strcmp(argv[i - 1], "--output") == 0) {
+            bench->output = value;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Times the game's hot paths on a sweep of board sizes and writes the results as JSON or CSV.
+ *
+ * Every benchmark runs a fixed number of operations several times; the fastest and the median
+ * repeat are reported in nanoseconds per operation, so runs can be compared between releases.
+ *
+ * @return 0 on successful execution, non-zero otherwise.
+ */
+int main(int argc, char **argv) {
+    static Bench bench;
+    bench.repeat = DEFAULT_BENCH_REPEAT;
+    bench.format = FORMAT_JSON;
+    parse_sizes(DEFAULT_BENCH_SIZES, &bench);
+
+    if (!parse_args(argc, argv, &bench)) {
+        fprintf(stderr, USAGE_MSG, argv[0]);
+        return 1;
+    }
+
+    for (int s = 0; s < bench.size_count; s++) {
+        int cols = bench.sizes[s][0];
+        int rows = bench.sizes[s][1];
+        bench_ticks(&bench, cols, rows);
+        bench_apple_spawn(&bench, cols, rows);
+        bench_collision(&bench, cols, rows);
+        bench_render(&bench, cols, rows);
+    }
+    bench_score_io(&bench);
+
+    FILE *out = bench.output != NULL ? fopen(bench.output, "w") : stdout;
+    if (out == NULL) {
+        fprintf(stderr, BENCH_OUTPUT_ERROR, bench.output);
+        return 1;
+    }
+
+    write_results(&bench, out);
+
+    if (out != stdout && fclose(out) != 0) {
+        fprintf(stderr, BENCH_OUTPUT_ERROR, bench.output);
+        return 1;
+    }
+
+    return 0;
+}
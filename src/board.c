@@ -0,0 +1,72 @@
+#include "../include//board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BOARD_SIZE_ERROR "ERROR: Board size %dx%d is outside %d..%d\n"
+#define BOARD_ALLOC_ERROR "ERROR: Out of memory while allocating a %dx%d board\n"
+
+/**
+ * @brief Allocates the per-cell storage for a board of the given size and clears it.
+ *
+ * A board that was already initialized is released first, so this can be used to resize.
+ *
+ * @param board A pointer to the Board struct to initialize; zero it before the first call.
+ * @param cols The number of columns, between BOARD_MIN_SIZE and BOARD_MAX_SIZE.
+ * @param rows The number of rows, between BOARD_MIN_SIZE and BOARD_MAX_SIZE.
+ *
+ * @return true on success, false if the size is out of range or memory ran out.
+ */
+bool init_board(Board *board, int cols, int rows) {
+    free_board(board);
+
+    if (cols < BOARD_MIN_SIZE || cols > BOARD_MAX_SIZE || rows < BOARD_MIN_SIZE || rows > BOARD_MAX_SIZE) {
+        fprintf(stderr, BOARD_SIZE_ERROR, cols, rows, BOARD_MIN_SIZE, BOARD_MAX_SIZE);
+        return false;
+    }
+
+    int cells = cols * rows;
+    board->occupied = malloc(((cells + 63) / 64) * sizeof(uint64_t));
+    board->free_cells = malloc(cells * sizeof(int32_t));
+    board->free_slot = malloc(cells * sizeof(int32_t));
+
+    if (board->occupied == NULL || board->free_cells == NULL || board->free_slot == NULL) {
+        fprintf(stderr, BOARD_ALLOC_ERROR, cols, rows);
+        free_board(board);
+        return false;
+    }
+
+    board->cols = cols;
+    board->rows = rows;
+    board->cells = cells;
+    clear_board(board);
+
+    return true;
+}
+
+/**
+ * @brief Releases the per-cell storage of a board.
+ *
+ * @param board A pointer to the Board struct to release.
+ */
+void free_board(Board *board) {
+    free(board->occupied);
+    free(board->free_cells);
+    free(board->free_slot);
+    memset(board, 0, sizeof(*board));
+}
+
+/**
+ * @brief Marks every cell of the board as free.
+ *
+ * @param board A pointer to the Board struct to clear.
+ */
+void clear_board(Board *board) {
+    memset(board->occupied, 0, ((board->cells + 63) / 64) * sizeof(uint64_t));
+
+    for (int i = 0; i < board->cells; i++) {
+        board->free_cells[i] = i;
+        board->free_slot[i] = i;
+    }
+    board->free_count = board->cells;
+}
@@ -0,0 +1,48 @@
+#include "../include//clock.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+#else
+
+#include <time.h>
+
+#endif
+
+/**
+ * @brief Returns the time of a monotonic clock, in seconds.
+ *
+ * The origin is unspecified, only differences between two calls are meaningful.
+ * Unlike raylib's GetTime(), this works before the window is created and in headless builds.
+ *
+ * @return The current time of the monotonic clock, in seconds.
+ */
+double clock_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * @brief Suspends the calling thread for about the given time, without spinning.
+ *
+ * @param seconds The time to sleep, in seconds; the system may round it up.
+ */
+void clock_sleep(double seconds) {
+#ifdef _WIN32
+    Sleep((DWORD) (seconds * 1000.0 + 0.5));
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t) seconds;
+    ts.tv_nsec = (long) ((seconds - (double) ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
+#endif
+}
@@ -1,162 +1,169 @@
 #include "../include//controllers.h"
-#include "../include//window.h"
 #include "raylib.h"
+#include "../include//render.h"
+#include "../include//window.h"
+#include "../include//replay.h"
 #include <stdbool.h>
 
 /**
- * @brief Draws a grid on the screen.
+ * @brief Handles the key inputs for the snake game.
  *
- * This function uses raylib's DrawRectangleLines function to draw a grid on the screen.
- * The grid is composed of cells, each with the specified width and height.
+ * This function drains every key pressed since the last call, in order, and queues the arrow keys
+ * as turns for the snake; the simulation applies one queued turn per tick. It is meant to be called
+ * every frame, so presses are timestamped as early as possible and quick double turns are kept.
+ * It also handles the pause functionality when the spacebar is pressed, and switches the
+ * autopilot on and off with AUTOPILOT_KEY.
  *
- * @param cols The number of columns in the grid.
- * @param rows The number of rows in the grid.
- * @param cell_width The width of each cell in the grid.
- * @param cell_height The height of each cell in the grid.
+ * @param input A pointer to the InputQueue struct that collects the turns.
+ * @param snake A pointer to the Snake struct representing the snake in the game.
+ * @param state A pointer to the GameState enum representing the current state of the game.
+ * @param autopilot A pointer to the flag telling whether the autopilot steers the snake.
  *
  * @return This function does not return any value.
  */
-void draw_grid(int cols, const int rows, const float cell_width, float cell_height) {
-    for (int i = 0; i < cols; i++) {
-        for (int j = 0; j < rows; j++) {
-            DrawRectangleLines(i * cell_width, j * cell_height, (int) cell_width,
-                               (int) cell_height, LIGHTGRAY);
+void handle_keys(InputQueue *input, const Snake *snake, GameState *state, bool *autopilot) {
+    double now = GetTime();
+    int key;
+
+    while ((key = GetKeyPressed()) != 0) {
+        switch (key) {
+            case KEY_SPACE:
+                *state = PAUSE;
+                break;
+            case AUTOPILOT_KEY:
+                // Turns queued before the switch are dropped, either way
+                *autopilot = !*autopilot;
+                clear_input_queue(input);
+                break;
+            case KEY_RIGHT:
+                push_turn(input, snake, RIGHT, now);
+                break;
+            case KEY_LEFT:
+                push_turn(input, snake, LEFT, now);
+                break;
+            case KEY_UP:
+                push_turn(input, snake, UP, now);
+                break;
+            case KEY_DOWN:
+                push_turn(input, snake, DOWN, now);
+                break;
+            default:
+                break;
         }
     }
 }
 
 /**
- * @brief Handles the key inputs for the snake game.
- *
- * This function checks if any of the arrow keys are pressed and updates the snake's direction accordingly.
- * It also handles the pause functionality when the spacebar is pressed.
+ * @brief Handles the camera zoom controls.
  *
- * @param snake A pointer to the Snake struct representing the snake in the game.
- * @param state A pointer to the GameState enum representing the current state of the game.
+ * The +/- keys (main row or keypad) and the mouse wheel zoom the board view in and out
+ * by CAMERA_ZOOM_STEP per press or notch. It works in every game state.
  *
  * @return This function does not return any value.
  */
-void handle_keys(Snake *snake, GameState *state) {
-    if (IsKeyDown(KEY_SPACE)) {
-        *state = PAUSE;
-    } else if (IsKeyDown(KEY_RIGHT) && snake->direction != LEFT) {
-        snake->direction = RIGHT;
-        snake->has_moved = true;
-    } else if (IsKeyDown(KEY_LEFT) && snake->direction != RIGHT) {
-        snake->direction = LEFT;
-        snake->has_moved = true;
-    } else if (IsKeyDown(KEY_UP) && snake->direction != DOWN) {
-        snake->direction = UP;
-        snake->has_moved = true;
-    } else if (IsKeyDown(KEY_DOWN) && snake->direction != UP) {
-        snake->direction = DOWN;
-        snake->has_moved = true;
-    }
+void handle_zoom(void) {
+    float steps = GetMouseWheelMove();
+
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD))
+        steps += 1.0f;
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT))
+        steps -= 1.0f;
+
+    for (; steps >= 1.0f; steps -= 1.0f)
+        zoom_camera(CAMERA_ZOOM_STEP);
+    for (; steps <= -1.0f; steps += 1.0f)
+        zoom_camera(1.0f / CAMERA_ZOOM_STEP);
 }
 
 
 /**
  * @brief Updates the game state.
  *
- * This function handles the game logic, including snake movement, apple consumption, and game over conditions.
- * It also updates the apple timer and draws the snake.
+ * This function advances the headless simulation by one fixed-length tick and turns the events
+ * it reports into side effects, such as queueing the eating sound for the audio dispatcher.
  *
- * @param snake A pointer to the Snake struct representing the snake in the game.
- * @param apple A pointer to the Apple struct representing the apple in the game.
- * @param state A pointer to the GameState enum representing the current state of the game.
+ * Before the tick, the autopilot steers the snake if it is on, otherwise the oldest queued turn
+ * (if any) is applied to the snake; either way the move is recorded.
  *
- * @return This function does not return any value.
+ * @param game A pointer to the Game struct holding the snake, the apple and the game state.
+ * @param input A pointer to the InputQueue struct holding the player's pending turns.
+ * @param autopilot A pointer to the Autopilot steering the snake, or NULL to follow the player's turns.
+ * @param replay A pointer to the Replay struct recording the game.
+ * @param assets A pointer to the Assets struct holding the sounds; nothing is played until audio is ready.
+ *
+ * @return The GameEvent flags reported by the simulation tick.
  */
-void update_game(Snake *snake, Apple *apple, GameState *state) {
-    Vector2 *snake_head = &snake->pos[0];
-    Vector2 prev_pos[100];  // Store previous positions of all snake segments
-
-    // Save current positions before any updates
-    for (int i = 0; i < snake->length; i++) {
-        prev_pos[i] = snake->pos[i];
+int update_game(Game *game, InputQueue *input, Autopilot *autopilot, Replay *replay, Assets *assets) {
+    if (autopilot != NULL) {
+        steer_autopilot(autopilot, game);
+    } else {
+        apply_turn(input, &game->snake, GetTime());
     }
+    record_tick(replay, &game->snake);
 
-    // Check if the snake has moved
-    if (snake->has_moved) {
-        // Move the snake's body first (update all segments except the head)
-        for (int i = snake->length - 1; i > 0; i--) {
-            snake->pos[i] = prev_pos[i - 1];
-        }
+    int events = tick_game(game, tick_interval(game));
+    queue_sounds(assets, events);
 
-        // Update the head's position based on its direction
-        switch (snake->direction) {
-            case UP:
-                snake_head->y -= 1;
-                break;
-            case DOWN:
-                snake_head->y += 1;
-                break;
-            case LEFT:
-                snake_head->x -= 1;
-                break;
-            case RIGHT:
-                snake_head->x += 1;
-                break;
-            default:
-                break;
-        }
-    }
-
-    // Check if the snake has hit a wall or itself
-    if (snake_head->x < 0 ||
-        snake_head->x >= COLS ||
-        snake_head->y < 0 ||
-        snake_head->y >= ROWS) {
-        // Set the game state to game over
-        *state = OVER;
-        return;
-    }
+    return events;
+}
 
-    // Check if the snake has hit itself
-    for (int i = 1; i < snake->length; i++) {
-        if (snake_head->x == snake->pos[i].x && snake_head->y == snake->pos[i].y) {
-            // Set the game state to game over
-            *state = OVER;
-            return;
-        }
+/**
+ * @brief Updates the game state from a replay instead of the player's input.
+ *
+ * Same as update_game(), except that the turn applied before the tick is the recorded one.
+ * The game ends as OVER if the recording runs out while the game is still being played.
+ *
+ * @param game A pointer to the Game struct set up with setup_replay_game().
+ * @param player A pointer to the ReplayPlayer playing the recording.
+ * @param assets A pointer to the Assets struct holding the sounds.
+ *
+ * @return The GameEvent flags reported by the simulation tick.
+ */
+int update_replay(Game *game, ReplayPlayer *player, Assets *assets) {
+    if (!playback_tick(player, &game->snake)) {
+        game->state = OVER;
+        return GAME_EVENT_NONE;
     }
 
-    // Check if the snake has eaten the apple
-    if (snake_head->x == apple->pos.x && snake_head->y == apple->pos.y) {
-        // Reset the apple timer and play the eating sound
-        start_timer(&apple->timer, apple->timer.lifetime);
-        PlaySound(apple->eating_sound);
-        // Increase the snake's score and length
-        snake->score++;
+    int events = tick_game(game, tick_interval(game));
+    queue_sounds(assets, events);
 
-        // Ensure we don't exceed our array bounds
-        if (snake->length + 1 < 100) {
-            // Add new segment at the end (copy last position)
-            snake->pos[snake->length] = prev_pos[snake->length - 1];
-            snake->length++;
-        }
+    return events;
+}
 
-        // Mark the apple as eaten
-        apple->eaten = true;
+/**
+ * @brief Undoes the last tick of the game, from the snapshots taken after each tick.
+ *
+ * The recording is cut back to match, so a rewound game is saved as it was finally played.
+ *
+ * @param game A pointer to the Game struct to rewind.
+ * @param snapshots A pointer to the SnapshotRing holding a snapshot of each tick.
+ * @param replay A pointer to the Replay struct recording the game.
+ *
+ * @return false if there is no older snapshot to go back to.
+ */
+bool rewind_game(Game *game, SnapshotRing *snapshots, Replay *replay) {
+    if (!rewind_ring(snapshots, game)) {
+        return false;
     }
 
-    // Update the apple timer
-    update_timer(&apple->timer);
-    // Draw the snake
-    draw_snake(snake);
+    rewind_replay(replay, replay->header.ticks - 1);
+    return true;
 }
 
 /**
- * @brief Restarts the game by resetting the snake and changing the game state.
+ * @brief Restarts the game by resetting the snake and the apple and changing the game state.
  *
- * This function initializes the snake using the init_snake function and sets the game state to PLAYING.
+ * This function initializes the game using the init_game function, which also sets the game state to PLAYING.
+ * The board keeps its size, so it is cleared rather than reallocated and the restart cannot fail.
+ * The next game's seed is drawn from the finished game's generator, so a whole session is
+ * reproducible from the first seed.
  *
- * @param snake A pointer to the Snake struct representing the snake in the game.
- * @param state A pointer to the GameState enum representing the current state of the game.
+ * @param game A pointer to the Game struct to restart.
  *
  * @return This function does not return any value.
  */
-void restart_game(Snake *snake, GameState *state) {
-    init_snake(snake);
-    *state = PLAYING;
+void restart_game(Game *game) {
+    game->seed = rng_next(&game->rng);
+    init_game(game);
 }
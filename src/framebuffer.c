@@ -0,0 +1,693 @@
+#include "../include//framebuffer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define FRAMEBUFFER_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define FRAMEBUFFER_NEON
+#include <arm_neon.h>
+#endif
+
+#define FRAMEBUFFER_ALLOC_ERROR "ERROR: Out of memory while allocating a %dx%d framebuffer\n"
+#define PNG_READ_WARNING "WARNING: %s is not a PNG this renderer can read\n"
+#define PNG_WRITE_WARNING "WARNING: Error while writing %s\n"
+
+#define SPAN_PIXELS 64            // Pixels blended per call, from a buffer on the stack.
+#define PNG_MAX_SIZE 16384        // Largest width or height read from a PNG.
+#define PNG_STORED_BLOCK 65535    // Largest uncompressed deflate block.
+
+static const uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+/**
+ * @brief Allocates a framebuffer, cleared to transparent black.
+ *
+ * A framebuffer that was already initialized is released first.
+ *
+ * @param framebuffer A pointer to the Framebuffer to initialize; zero it before the first call.
+ * @param width The width in pixels.
+ * @param height The height in pixels.
+ *
+ * @return false if the size is not positive or memory ran out.
+ */
+bool init_framebuffer(Framebuffer *framebuffer, int width, int height) {
+    free_framebuffer(framebuffer);
+
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    framebuffer->pixels = calloc((size_t) width * height, 4);
+    if (framebuffer->pixels == NULL) {
+        fprintf(stderr, FRAMEBUFFER_ALLOC_ERROR, width, height);
+        return false;
+    }
+
+    framebuffer->width = width;
+    framebuffer->height = height;
+    return true;
+}
+
+/**
+ * @brief Releases the pixels of a framebuffer.
+ *
+ * @param framebuffer A pointer to the Framebuffer to release.
+ */
+void free_framebuffer(Framebuffer *framebuffer) {
+    free(framebuffer->pixels);
+    memset(framebuffer, 0, sizeof(*framebuffer));
+}
+
+/**
+ * @brief Divides a product of two 8-bit values by 255, the same way in every code path.
+ */
+static inline unsigned div255(unsigned x) {
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+/**
+ * @brief Blends one pixel over another: each channel becomes src * a + dst * (1 - a), alpha included
+ * with a source value of 1, where a is the source pixel's alpha.
+ */
+static inline void blend_pixel(uint8_t *dst, const uint8_t *src) {
+    unsigned a = src[3];
+
+    dst[0] = (uint8_t) div255(src[0] * a + dst[0] * (255 - a));
+    dst[1] = (uint8_t) div255(src[1] * a + dst[1] * (255 - a));
+    dst[2] = (uint8_t) div255(src[2] * a + dst[2] * (255 - a));
+    dst[3] = (uint8_t) div255(255 * a + dst[3] * (255 - a));
+}
+
+#ifdef FRAMEBUFFER_SSE2
+
+/**
+ * @brief blend_pixel() on two pixels widened to 16-bit lanes.
+ */
+static inline __m128i blend_wide(__m128i dst, __m128i src, __m128i alpha) {
+    const __m128i ff = _mm_set1_epi16(255);
+    const __m128i one = _mm_set1_epi16(1);
+
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, _mm_sub_epi16(ff, alpha)));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_add_epi16(one, _mm_srli_epi16(x, 8))), 8);
+}
+
+/**
+ * @brief blend_pixel() on four pixels at once.
+ */
+static inline void blend4(uint8_t *dst, const uint8_t *src) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set1_epi32((int) 0xFF000000u);  // The alpha byte of each pixel
+
+    __m128i s = _mm_loadu_si128((const __m128i *) src);
+    __m128i d = _mm_loadu_si128((const __m128i *) dst);
+
+    __m128i alpha_lo = _mm_unpacklo_epi8(s, zero);
+    __m128i alpha_hi = _mm_unpackhi_epi8(s, zero);
+    alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(alpha_lo, 0xFF), 0xFF);
+    alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(alpha_hi, 0xFF), 0xFF);
+
+    s = _mm_or_si128(s, opaque);
+    __m128i lo = blend_wide(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), alpha_lo);
+    __m128i hi = blend_wide(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), alpha_hi);
+
+    _mm_storeu_si128((__m128i *) dst, _mm_packus_epi16(lo, hi));
+}
+
+#define BLEND_GROUP 4
+
+#elif defined(FRAMEBUFFER_NEON)
+
+/**
+ * @brief blend_pixel() on two pixels at once.
+ */
+static inline void blend2(uint8_t *dst, const uint8_t *src) {
+    static const uint8_t alpha_lanes[8] = {3, 3, 3, 3, 7, 7, 7, 7};
+    static const uint8_t alpha_bytes[8] = {0, 0, 0, 255, 0, 0, 0, 255};
+
+    uint8x8_t s = vld1_u8(src);
+    uint8x8_t d = vld1_u8(dst);
+    uint8x8_t a = vtbl1_u8(s, vld1_u8(alpha_lanes));
+
+    uint16x8_t x = vmull_u8(vorr_u8(s, vld1_u8(alpha_bytes)), a);
+    x = vmlal_u8(x, d, vsub_u8(vdup_n_u8(255), a));
+    x = vaddq_u16(x, vaddq_u16(vdupq_n_u16(1), vshrq_n_u16(x, 8)));
+
+    vst1_u8(dst, vshrn_n_u16(x, 8));
+}
+
+#define BLEND_GROUP 2
+
+#endif
+
+/**
+ * @brief Blends a run of pixels over another.
+ */
+static void blend_span(uint8_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+
+#if defined(FRAMEBUFFER_SSE2)
+    for (; i + BLEND_GROUP <= count; i += BLEND_GROUP) {
+        blend4(dst + i * 4, src + i * 4);
+    }
+#elif defined(FRAMEBUFFER_NEON)
+    for (; i + BLEND_GROUP <= count; i += BLEND_GROUP) {
+        blend2(dst + i * 4, src + i * 4);
+    }
+#endif
+
+    for (; i < count; i++) {
+        blend_pixel(dst + i * 4, src + i * 4);
+    }
+}
+
+/**
+ * @brief Sets a run of pixels to one color.
+ */
+static void fill_span(uint8_t *dst, uint32_t pattern, int count) {
+    int i = 0;
+
+#if defined(FRAMEBUFFER_SSE2)
+    __m128i wide = _mm_set1_epi32((int) pattern);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128((__m128i *) (dst + i * 4), wide);
+    }
+#elif defined(FRAMEBUFFER_NEON)
+    uint32x4_t wide = vdupq_n_u32(pattern);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u8(dst + i * 4, vreinterpretq_u8_u32(wide));
+    }
+#endif
+
+    for (; i < count; i++) {
+        memcpy(dst + i * 4, &pattern, 4);
+    }
+}
+
+/**
+ * @brief Returns the first pixel whose center lies at or after a coordinate, clamped to [0, size].
+ */
+static int first_pixel(float v, int size) {
+    float p = ceilf(v - 0.5f);
+    return p < 0.0f ? 0 : p > (float) size ? size : (int) p;
+}
+
+/**
+ * @brief Sets every pixel of a framebuffer to one color, alpha included.
+ *
+ * @param framebuffer A pointer to the Framebuffer.
+ * @param color The color.
+ */
+void clear_framebuffer(Framebuffer *framebuffer, RenderColor color) {
+    uint32_t pattern;
+    memcpy(&pattern, &color, 4);
+
+    fill_span(framebuffer->pixels, pattern, framebuffer->width * framebuffer->height);
+}
+
+/**
+ * @brief Fills a rectangle, blending the color over the pixels if it is not opaque.
+ *
+ * @param framebuffer A pointer to the Framebuffer.
+ * @param x The left edge of the rectangle, in pixels; may be fractional or off the framebuffer.
+ * @param y The top edge of the rectangle.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param color The color to fill with.
+ */
+void fill_framebuffer_rect(Framebuffer *framebuffer, float x, float y, float width, float height, RenderColor color) {
+    int x0 = first_pixel(x, framebuffer->width);
+    int x1 = first_pixel(x + width, framebuffer->width);
+    int y0 = first_pixel(y, framebuffer->height);
+    int y1 = first_pixel(y + height, framebuffer->height);
+
+    if (x1 <= x0 || y1 <= y0 || color.a == 0) {
+        return;
+    }
+
+    const size_t stride = (size_t) framebuffer->width * 4;
+    uint8_t *row = framebuffer->pixels + y0 * stride + x0 * 4;
+
+    if (color.a == 255) {
+        uint32_t pattern;
+        memcpy(&pattern, &color, 4);
+        for (int py = y0; py < y1; py++, row += stride) {
+            fill_span(row, pattern, x1 - x0);
+        }
+        return;
+    }
+
+    uint8_t span[SPAN_PIXELS * 4];
+    for (int i = 0; i < SPAN_PIXELS; i++) {
+        memcpy(span + i * 4, &color, 4);
+    }
+
+    for (int py = y0; py < y1; py++, row += stride) {
+        for (int px = 0; px < x1 - x0; px += SPAN_PIXELS) {
+            int count = x1 - x0 - px < SPAN_PIXELS ? x1 - x0 - px : SPAN_PIXELS;
+            blend_span(row + px * 4, span, count);
+        }
+    }
+}
+
+/**
+ * @brief Draws an image scaled over a rectangle, nearest-neighbour, tinted and blended by its alpha.
+ *
+ * @param framebuffer A pointer to the Framebuffer to draw into.
+ * @param image A pointer to the Framebuffer holding the image.
+ * @param x The left edge of the rectangle, in pixels; may be fractional or off the framebuffer.
+ * @param y The top edge of the rectangle.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param tint The color each of the image's channels is multiplied with, white to leave it as it is.
+ */
+void blit_framebuffer(Framebuffer *framebuffer, const Framebuffer *image, float x, float y, float width, float height,
+                      RenderColor tint) {
+    int x0 = first_pixel(x, framebuffer->width);
+    int x1 = first_pixel(x + width, framebuffer->width);
+    int y0 = first_pixel(y, framebuffer->height);
+    int y1 = first_pixel(y + height, framebuffer->height);
+
+    if (x1 <= x0 || y1 <= y0 || image->pixels == NULL) {
+        return;
+    }
+
+    const size_t stride = (size_t) framebuffer->width * 4;
+    const size_t image_stride = (size_t) image->width * 4;
+    const bool tinted = tint.r != 255 || tint.g != 255 || tint.b != 255 || tint.a != 255;
+    uint8_t span[SPAN_PIXELS * 4];
+
+    for (int py = y0; py < y1; py++) {
+        int v = (int) ((py + 0.5f - y) * image->height / height);
+        v = v < 0 ? 0 : v >= image->height ? image->height - 1 : v;
+        const uint8_t *source = image->pixels + v * image_stride;
+        uint8_t *row = framebuffer->pixels + py * stride;
+
+        for (int px = x0; px < x1; px += SPAN_PIXELS) {
+            int count = x1 - px < SPAN_PIXELS ? x1 - px : SPAN_PIXELS;
+
+            // Gather the source pixels of this run, then blend them all at once
+            for (int i = 0; i < count; i++) {
+                int u = (int) ((px + i + 0.5f - x) * image->width / width);
+                u = u < 0 ? 0 : u >= image->width ? image->width - 1 : u;
+                uint8_t *pixel = span + i * 4;
+                memcpy(pixel, source + u * 4, 4);
+
+                if (tinted) {
+                    pixel[0] = (uint8_t) div255(pixel[0] * tint.r);
+                    pixel[1] = (uint8_t) div255(pixel[1] * tint.g);
+                    pixel[2] = (uint8_t) div255(pixel[2] * tint.b);
+                    pixel[3] = (uint8_t) div255(pixel[3] * tint.a);
+                }
+            }
+
+            blend_span(row + px * 4, span, count);
+        }
+    }
+}
+
+static void framebuffer_begin_rects(void *target, int count) {
+    (void) target;
+    (void) count;
+}
+
+static void framebuffer_fill_rect(void *target, float x, float y, float width, float height, RenderColor color) {
+    fill_framebuffer_rect(target, x, y, width, height, color);
+}
+
+static void framebuffer_end_rects(void *target) {
+    (void) target;
+}
+
+static void framebuffer_draw_image(void *target, const void *image, float x, float y, float width, float height,
+                                   RenderColor tint) {
+    blit_framebuffer(target, image, x, y, width, height, tint);
+}
+
+/**
+ * @brief Returns a render backend that draws into a framebuffer; its images are Framebuffers too.
+ *
+ * @param framebuffer A pointer to the Framebuffer to draw into.
+ */
+RenderBackend framebuffer_backend(Framebuffer *framebuffer) {
+    RenderBackend backend = {
+            framebuffer,
+            framebuffer_begin_rects,
+            framebuffer_fill_rect,
+            framebuffer_end_rects,
+            framebuffer_draw_image,
+    };
+    return backend;
+}
+
+/**
+ * @brief Draws a stand-in for the apple texture, for renders that run without raylib to decode it.
+ *
+ * @param sprite A pointer to the Framebuffer to draw into; zero it before the first call.
+ * @param size The width and height of the sprite, in pixels.
+ *
+ * @return false if memory ran out.
+ */
+bool build_apple_sprite(Framebuffer *sprite, int size) {
+    if (!init_framebuffer(sprite, size, size)) {
+        return false;
+    }
+
+    // A red disc with a green leaf on top, on a transparent background
+    float center = size / 2.0f;
+    float radius = size * 0.4f;
+    for (int py = 0; py < size; py++) {
+        for (int px = 0; px < size; px++) {
+            float dx = px + 0.5f - center;
+            float dy = py + 0.5f - center - size * 0.05f;
+            if (dx * dx + dy * dy <= radius * radius) {
+                fill_framebuffer_rect(sprite, (float) px, (float) py, 1.0f, 1.0f, RENDER_RED);
+            }
+        }
+    }
+    fill_framebuffer_rect(sprite, center, size * 0.05f, size * 0.2f, size * 0.12f, RENDER_DARKGREEN);
+
+    return true;
+}
+
+static uint32_t crc_table[256];
+static bool crc_table_ready = false;
+
+/**
+ * @brief Continues a CRC-32 (the PNG and zlib polynomial) over a buffer.
+ */
+static uint32_t update_crc(uint32_t crc, const uint8_t *data, size_t size) {
+    if (!crc_table_ready) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            crc_table[n] = c;
+        }
+        crc_table_ready = true;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = crc_table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Computes the Adler-32 checksum that ends a zlib stream.
+ */
+static uint32_t adler32(const uint8_t *data, size_t size) {
+    uint32_t a = 1, b = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+static void put_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t) (v >> 24);
+    p[1] = (uint8_t) (v >> 16);
+    p[2] = (uint8_t) (v >> 8);
+    p[3] = (uint8_t) v;
+}
+
+static uint32_t get_be32(const uint8_t *p) {
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Writes one PNG chunk: length, type, data and CRC.
+ */
+static bool write_chunk(FILE *f, const char *type, const uint8_t *data, size_t size) {
+    uint8_t header[8];
+    uint8_t trailer[4];
+
+    put_be32(header, (uint32_t) size);
+    memcpy(header + 4, type, 4);
+    put_be32(trailer, update_crc(update_crc(0, header + 4, 4), data, size));
+
+    return fwrite(header, 8, 1, f) == 1 && (size == 0 || fwrite(data, size, 1, f) == 1) &&
+           fwrite(trailer, 4, 1, f) == 1;
+}
+
+/**
+ * @brief Writes a framebuffer as an 8-bit RGBA PNG.
+ *
+ * The image data is stored without compression, which keeps the writer (and the reader of golden
+ * images) small; the files are about the size of the framebuffer.
+ *
+ * @param framebuffer A pointer to the Framebuffer to write.
+ * @param path The path of the PNG file.
+ *
+ * @return false if the file could not be written.
+ */
+bool save_framebuffer_png(const Framebuffer *framebuffer, const char *path) {
+    const size_t row_size = (size_t) framebuffer->width * 4 + 1;  // Each row starts with its filter type, 0
+    const size_t raw_size = row_size * framebuffer->height;
+    const size_t blocks = (raw_size + PNG_STORED_BLOCK - 1) / PNG_STORED_BLOCK;
+    const size_t idat_size = 2 + raw_size + 5 * blocks + 4;
+
+    uint8_t *raw = malloc(raw_size);
+    uint8_t *idat = malloc(idat_size);
+    if (raw == NULL || idat == NULL) {
+        free(raw);
+        free(idat);
+        fprintf(stderr, PNG_WRITE_WARNING, path);
+        return false;
+    }
+
+    for (int y = 0; y < framebuffer->height; y++) {
+        raw[y * row_size] = 0;
+        memcpy(raw + y * row_size + 1, framebuffer->pixels + (size_t) y * framebuffer->width * 4, row_size - 1);
+    }
+
+    // A zlib stream made of stored deflate blocks
+    uint8_t *p = idat;
+    *p++ = 0x78;
+    *p++ = 0x01;
+    for (size_t offset = 0; offset < raw_size; offset += PNG_STORED_BLOCK) {
+        size_t size = raw_size - offset < PNG_STORED_BLOCK ? raw_size - offset : PNG_STORED_BLOCK;
+        *p++ = offset + size == raw_size;
+        *p++ = (uint8_t) size;
+        *p++ = (uint8_t) (size >> 8);
+        *p++ = (uint8_t) ~size;
+        *p++ = (uint8_t) (~size >> 8);
+        memcpy(p, raw + offset, size);
+        p += size;
+    }
+    put_be32(p, adler32(raw, raw_size));
+
+    uint8_t ihdr[13] = {0};
+    put_be32(ihdr, (uint32_t) framebuffer->width);
+    put_be32(ihdr + 4, (uint32_t) framebuffer->height);
+    ihdr[8] = 8;  // Bits per channel
+    ihdr[9] = 6;  // RGBA
+
+    FILE *f = fopen(path, "wb");
+    bool ok = f != NULL &&
+              fwrite(PNG_SIGNATURE, sizeof(PNG_SIGNATURE), 1, f) == 1 &&
+              write_chunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+              write_chunk(f, "IDAT", idat, idat_size) &&
+              write_chunk(f, "IEND", NULL, 0);
+
+    if (f != NULL && fclose(f) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        fprintf(stderr, PNG_WRITE_WARNING, path);
+    }
+
+    free(raw);
+    free(idat);
+    return ok;
+}
+
+/**
+ * @brief Reads a whole file into memory.
+ */
+static uint8_t *read_file(const char *path, size_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return NULL;
+    }
+
+    uint8_t *data = NULL;
+    long length = fseek(f, 0, SEEK_END) == 0 ? ftell(f) : -1;
+    if (length > 0 && fseek(f, 0, SEEK_SET) == 0 && (data = malloc(length)) != NULL &&
+        fread(data, length, 1, f) != 1) {
+        free(data);
+        data = NULL;
+    }
+
+    fclose(f);
+    *size = length > 0 ? (size_t) length : 0;
+    return data;
+}
+
+/**
+ * @brief Undoes a PNG row filter, in place, given the previous row already unfiltered (or NULL).
+ */
+static bool unfilter_row(uint8_t type, uint8_t *row, const uint8_t *previous, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        int left = i >= 4 ? row[i - 4] : 0;
+        int up = previous != NULL ? previous[i] : 0;
+        int up_left = i >= 4 && previous != NULL ? previous[i - 4] : 0;
+
+        switch (type) {
+            case 0:
+                return true;
+            case 1:
+                row[i] = (uint8_t) (row[i] + left);
+                break;
+            case 2:
+                row[i] = (uint8_t) (row[i] + up);
+                break;
+            case 3:
+                row[i] = (uint8_t) (row[i] + (left + up) / 2);
+                break;
+            case 4: {
+                int p = left + up - up_left;
+                int pa = abs(p - left), pb = abs(p - up), pc = abs(p - up_left);
+                row[i] = (uint8_t) (row[i] + (pa <= pb && pa <= pc ? left : pb <= pc ? up : up_left));
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes PNG image data stored in uncompressed deflate blocks, as save_framebuffer_png() writes it.
+ */
+static bool read_stored_zlib(const uint8_t *data, size_t size, uint8_t *out, size_t out_size) {
+    if (size < 6 || (data[0] & 0x0f) != 8 || (data[0] * 256 + data[1]) % 31 != 0 || (data[1] & 0x20)) {
+        return false;
+    }
+
+    size_t in = 2, written = 0;
+    bool final = false;
+    while (!final) {
+        if (in + 5 > size) {
+            return false;
+        }
+        final = data[in] & 1;
+        if ((data[in] >> 1) & 3) {
+            return false;  // A compressed block
+        }
+
+        size_t length = data[in + 1] | (data[in + 2] << 8);
+        size_t check = data[in + 3] | (data[in + 4] << 8);
+        in += 5;
+        if ((length ^ 0xffff) != check || in + length > size || written + length > out_size) {
+            return false;
+        }
+
+        memcpy(out + written, data + in, length);
+        in += length;
+        written += length;
+    }
+
+    return written == out_size && in + 4 <= size && get_be32(data + in) == adler32(out, out_size);
+}
+
+/**
+ * @brief Reads an 8-bit RGBA PNG, such as a golden image written by save_framebuffer_png().
+ *
+ * Only images whose data is stored without compression can be read; any row filter is accepted.
+ *
+ * @param framebuffer A pointer to the Framebuffer to fill in; zero it before the first call.
+ * @param path The path of the PNG file.
+ *
+ * @return false if the file cannot be read or is not such a PNG.
+ */
+bool load_framebuffer_png(Framebuffer *framebuffer, const char *path) {
+    size_t size = 0;
+    uint8_t *file = read_file(path, &size);
+    uint8_t *idat = NULL;
+    uint8_t *raw = NULL;
+    size_t idat_size = 0;
+    int width = 0, height = 0;
+    bool ok = file != NULL && size >= sizeof(PNG_SIGNATURE) && memcmp(file, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0;
+
+    // Gather the header and the image data, checking every chunk's CRC
+    size_t offset = sizeof(PNG_SIGNATURE);
+    bool ended = false;
+    while (ok && !ended && offset + 12 <= size) {
+        size_t length = get_be32(file + offset);
+        const uint8_t *type = file + offset + 4;
+        const uint8_t *data = file + offset + 8;
+
+        if (length > size - offset - 12 || update_crc(update_crc(0, type, 4), data, length) != get_be32(data + length)) {
+            ok = false;
+        } else if (memcmp(type, "IHDR", 4) == 0) {
+            width = (int) get_be32(data);
+            height = (int) get_be32(data + 4);
+            ok = length == 13 && width > 0 && width <= PNG_MAX_SIZE && height > 0 && height <= PNG_MAX_SIZE &&
+                 data[8] == 8 && data[9] == 6 && data[10] == 0 && data[11] == 0 && data[12] == 0;
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            uint8_t *grown = realloc(idat, idat_size + length);
+            ok = grown != NULL;
+            if (ok) {
+                idat = grown;
+                memcpy(idat + idat_size, data, length);
+                idat_size += length;
+            }
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            ended = true;
+        }
+        offset += length + 12;
+    }
+
+    size_t row_size = (size_t) width * 4 + 1;
+    ok = ok && ended && width > 0 && (raw = malloc(row_size * height)) != NULL &&
+         read_stored_zlib(idat, idat_size, raw, row_size * height) && init_framebuffer(framebuffer, width, height);
+
+    for (int y = 0; ok && y < height; y++) {
+        uint8_t *row = raw + y * row_size;
+        ok = unfilter_row(row[0], row + 1, y > 0 ? row - row_size + 1 : NULL, row_size - 1);
+        memcpy(framebuffer->pixels + (size_t) y * width * 4, row + 1, row_size - 1);
+    }
+
+    if (!ok) {
+        fprintf(stderr, PNG_READ_WARNING, path);
+    }
+
+    free(file);
+    free(idat);
+    free(raw);
+    return ok;
+}
+
+/**
+ * @brief Compares two framebuffers pixel by pixel.
+ *
+ * @param a A pointer to the first Framebuffer.
+ * @param b A pointer to the second Framebuffer.
+ * @param tolerance The largest difference allowed in any channel of a pixel.
+ *
+ * @return The number of pixels that differ by more than the tolerance, or -1 if the sizes differ.
+ */
+long compare_framebuffers(const Framebuffer *a, const Framebuffer *b, int tolerance) {
+    if (a->width != b->width || a->height != b->height) {
+        return -1;
+    }
+
+    long differing = 0;
+    size_t pixels = (size_t) a->width * a->height;
+    for (size_t i = 0; i < pixels; i++) {
+        const uint8_t *p = a->pixels + i * 4;
+        const uint8_t *q = b->pixels + i * 4;
+        differing += abs(p[0] - q[0]) > tolerance || abs(p[1] - q[1]) > tolerance ||
+                     abs(p[2] - q[2]) > tolerance || abs(p[3] - q[3]) > tolerance;
+    }
+
+    return differing;
+}
@@ -0,0 +1,208 @@
+#include "../include//game.h"
+
+/**
+ * @brief Initializes a new game.
+ *
+ * This function places a new snake on the board, marks its cells as occupied,
+ * resets the apple spawn timer and spawns the first apple.
+ * The Game struct must be zero-initialized before the first call and released with free_game().
+ * The board size and tick rate set before the first call (0 picks the defaults) are kept across
+ * restarts; the board is only reallocated when its size changes.
+ * The game's random number generator is seeded from game->seed, so the same seed and the same
+ * inputs always play out the same game, on any thread.
+ *
+ * @param game A pointer to the Game struct to initialize.
+ *
+ * @return true on success, false if the board size is invalid or the board could not be allocated.
+ */
+bool init_game(Game *game) {
+    if (game->cols <= 0) {
+        game->cols = DEFAULT_COLS;
+    }
+    if (game->rows <= 0) {
+        game->rows = DEFAULT_ROWS;
+    }
+    if (game->tick_rate <= 0) {
+        game->tick_rate = DEFAULT_TICK_RATE;
+    }
+
+    if (game->board.cols != game->cols || game->board.rows != game->rows) {
+        if (!init_board(&game->board, game->cols, game->rows)) {
+            return false;
+        }
+    } else {
+        clear_board(&game->board);
+    }
+
+    rng_seed(&game->rng, game->seed);
+
+    init_snake(&game->snake, game->cols, game->rows, &game->rng);
+    for (int i = 0; i < game->snake.length; i++) {
+        board_occupy(&game->board, snake_segment(&game->snake, i));
+    }
+
+    game->apple.timer.lifetime = APPLE_SPAWN_DELAY;
+    game->apple.timer.active = false;
+    game->apple.first_render = true;
+    game->apple.eaten = true;
+    spawn_apple(&game->apple, &game->board, &game->rng);
+
+    game->state = PLAYING;
+    game->elapsed = 0.0;
+
+    return true;
+}
+
+/**
+ * @brief Releases the memory owned by a game.
+ *
+ * @param game A pointer to the Game struct to release.
+ */
+void free_game(Game *game) {
+    free_snake(&game->snake);
+    free_board(&game->board);
+}
+
+/**
+ * @brief The tick rules, written against an explicit board size.
+ *
+ * tick_game() instantiates this with compile-time constants for the common board sizes, where the
+ * compiler folds the index arithmetic and bounds checks, and with the runtime size for the rest.
+ */
+static inline int tick_board(Game *game, double dt, const int cols, const int rows) {
+    Board *board = &game->board;
+    Snake *snake = &game->snake;
+    Apple *apple = &game->apple;
+
+    if (game->state != PLAYING) {
+        return GAME_EVENT_NONE;
+    }
+
+    int events = GAME_EVENT_NONE;
+    game->elapsed += dt;
+
+    // Remember where the snake was, so the renderer can interpolate between ticks
+    snake->prev_head = snake_head(snake);
+    snake->prev_tail = snake_tail(snake);
+
+    // Check if the snake has moved
+    if (snake->has_moved) {
+        Cell next = snake_head(snake);
+
+        // Compute the head's next position based on its direction
+        switch (snake->direction) {
+            case UP:
+                next.y -= 1;
+                break;
+            case DOWN:
+                next.y += 1;
+                break;
+            case LEFT:
+                next.x -= 1;
+                break;
+            case RIGHT:
+                next.x += 1;
+                break;
+            default:
+                break;
+        }
+
+        // Check if the snake has hit a wall
+        if (!cell_in_bounds(next, cols, rows)) {
+            game->state = OVER;
+            return GAME_EVENT_DIED;
+        }
+
+        // Check if the snake is about to eat the apple (an eaten apple stays hidden until it respawns)
+        bool eats = !apple->eaten && next.x == apple->pos.x && next.y == apple->pos.y;
+
+        // The tail leaves its cell before the head moves, so following the tail closely is allowed
+        Cell tail = snake_tail(snake);
+        int tail_index = cell_index(tail, cols);
+        int next_index = cell_index(next, cols);
+        board_release_at(board, tail_index);
+
+        // Check if the snake has hit itself
+        if (board_occupied_at(board, next_index)) {
+            game->state = OVER;
+            return GAME_EVENT_DIED;
+        }
+
+        // A growing snake keeps its tail instead of dropping it
+        if (advance_snake(snake, next, eats && snake->length < cols * rows)) {
+            board_occupy_at(board, tail_index);
+        }
+        board_occupy_at(board, next_index);
+
+        if (eats) {
+            start_timer(&apple->timer, APPLE_SPAWN_DELAY);
+            snake->score++;
+            apple->eaten = true;
+            events |= GAME_EVENT_ATE_APPLE;
+        }
+    }
+
+    update_timer(&apple->timer, dt);
+
+    // No free cell left for the next apple: the snake covers the whole board
+    if (board->free_count == 0 || !spawn_apple(apple, board, &game->rng)) {
+        game->state = WON;
+        events |= GAME_EVENT_WON;
+    }
+
+    return events;
+}
+
+// Board sizes that get their own copy of the tick rules, with the size known at compile time
+#define FIXED_BOARD_SIZES(X) \
+    X(32, 24)                \
+    X(64, 48)                \
+    X(16, 12)
+
+#define DEFINE_FIXED_TICK(COLS, ROWS)                              \
+    static int tick_board_##COLS##x##ROWS(Game *game, double dt) { \
+        return tick_board(game, dt, COLS, ROWS);                   \
+    }
+
+FIXED_BOARD_SIZES(DEFINE_FIXED_TICK)
+
+/**
+ * @brief Advances the game by one simulation tick.
+ *
+ * This function handles the game rules: snake movement, wall and self collisions, apple consumption
+ * and apple respawning. It has no side effects besides updating the game state; anything the player
+ * should see or hear is reported through the returned event flags.
+ *
+ * Self collisions are looked up in the occupancy board, which is updated incrementally as the tail
+ * leaves its cell and the head enters a new one, so a tick costs the same for any snake length.
+ * Boards listed in FIXED_BOARD_SIZES run a copy of the rules specialized for their size.
+ *
+ * @param game A pointer to the Game struct to advance.
+ * @param dt The time covered by this tick, in seconds. Used by the apple spawn timer.
+ *
+ * @return A combination of GameEvent flags describing what happened during the tick.
+ */
+int tick_game(Game *game, double dt) {
+    const int cols = game->board.cols;
+    const int rows = game->board.rows;
+
+#define DISPATCH_FIXED_TICK(COLS, ROWS)              \
+    if (cols == COLS && rows == ROWS) {              \
+        return tick_board_##COLS##x##ROWS(game, dt); \
+    }
+    FIXED_BOARD_SIZES(DISPATCH_FIXED_TICK)
+#undef DISPATCH_FIXED_TICK
+
+    return tick_board(game, dt, cols, rows);
+}
+
+/**
+ * @brief Returns the simulated time covered by one tick.
+ *
+ * @param game A pointer to the Game struct.
+ *
+ * @return The tick interval, in seconds.
+ */
+double tick_interval(const Game *game) {
+    return 1.0 / (game->tick_rate > 0 ? game->tick_rate : DEFAULT_TICK_RATE);
+}
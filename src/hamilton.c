@@ -0,0 +1,186 @@
+#include "../include//hamilton.h"
+#include <stddef.h>
+
+#define NO_CELL (-1)
+
+/**
+ * @brief Returns the index of a cell of the grid the cycle is laid out on.
+ */
+static inline int cycle_cell(int u, int v, int cols, bool transposed) {
+    return transposed ? u * cols + v : v * cols + u;
+}
+
+/**
+ * @brief Lays a Hamiltonian cycle out on a board.
+ *
+ * The cycle runs along the first row, zigzags back and forth through the other rows without
+ * touching the first column, and comes back up the first column. The zigzag ends next to the
+ * first column when the number of rows is even, so the board is transposed when only the number
+ * of columns is.
+ *
+ * @param position An array of cols * rows entries, set to the position of each cell along the cycle.
+ * @param cols The number of columns of the board.
+ * @param rows The number of rows of the board; has_hamilton_cycle() must hold.
+ */
+void build_hamilton_cycle(int32_t *position, int cols, int rows) {
+    bool transposed = rows % 2 != 0;
+    int width = transposed ? rows : cols;
+    int height = transposed ? cols : rows;
+    int32_t step = 0;
+
+    for (int u = 0; u < width; u++) {
+        position[cycle_cell(u, 0, cols, transposed)] = step++;
+    }
+    for (int v = 1; v < height; v++) {
+        if (v % 2 != 0) {
+            for (int u = width - 1; u >= 1; u--) {
+                position[cycle_cell(u, v, cols, transposed)] = step++;
+            }
+        } else {
+            for (int u = 1; u < width; u++) {
+                position[cycle_cell(u, v, cols, transposed)] = step++;
+            }
+        }
+    }
+    for (int v = height - 1; v >= 1; v--) {
+        position[cycle_cell(0, v, cols, transposed)] = step++;
+    }
+}
+
+/**
+ * @brief Returns how far along the cycle a cell lies behind another one.
+ */
+static inline int cycle_behind(const Autopilot *autopilot, int cells, int from, int cell) {
+    int behind = autopilot->cycle[from] - autopilot->cycle[cell];
+    return behind < 0 ? behind + cells : behind;
+}
+
+/**
+ * @brief Works out how many tail-most segments may lie out of order along the cycle.
+ *
+ * As long as the snake only makes the moves hamilton_decide() allows, each segment lies farther
+ * behind the head along the cycle than the one before it, and the count only drops as the tail
+ * moves on. Any other move, a new game or a rewind is noticed here and the body is scanned again.
+ */
+static void sync_cycle(Autopilot *autopilot, const Game *game, int head) {
+    const Board *board = &game->board;
+    const Snake *snake = &game->snake;
+    int length = snake->length;
+
+    if (game->elapsed > 0.0 && head == autopilot->cycle_next &&
+        (length == autopilot->cycle_length || length == autopilot->cycle_length + 1)) {
+        // Unless the snake just ate, its tail moved on, taking one of the unordered segments along
+        if (length == autopilot->cycle_length && autopilot->cycle_unordered > 0) {
+            autopilot->cycle_unordered--;
+        }
+        return;
+    }
+
+    int ordered = 1;
+    int previous = 0;
+    while (ordered < length) {
+        int behind = cycle_behind(autopilot, board->cells, head, board_index(board, snake_segment(snake, ordered)));
+        if (behind <= previous) {
+            break;
+        }
+        previous = behind;
+        ordered++;
+    }
+    autopilot->cycle_unordered = length - ordered;
+}
+
+/**
+ * @brief Picks the direction for the next tick by following the board's Hamiltonian cycle, with shortcuts.
+ *
+ * Following the cycle visits every cell, so the snake always fills the board. A shortcut skips
+ * ahead along the cycle, and is safe as long as it lands before the segment farthest behind the
+ * head: then the body still lies along the cycle in order, the tail first, and the next cell of
+ * the cycle is always free or the tail. Of the safe moves, the one skipping farthest without
+ * passing the apple is taken; the snake follows the cycle while no apple is showing.
+ * Boards without a cycle, and bodies too tangled for any safe move, are left to autopilot_decide().
+ *
+ * @param autopilot A pointer to an Autopilot initialized for the game's board size.
+ * @param game A pointer to the game to play.
+ *
+ * @return The direction for the next tick.
+ */
+Dir hamilton_decide(Autopilot *autopilot, const Game *game) {
+    if (autopilot->cycle == NULL) {
+        return autopilot_decide(autopilot, game);
+    }
+
+    const Board *board = &game->board;
+    const Snake *snake = &game->snake;
+    const int cells = board->cells;
+    const int cols = board->cols;
+    int length = snake->length;
+    int head = board_index(board, snake_head(snake));
+    int tail = board_index(board, snake_tail(snake));
+
+    sync_cycle(autopilot, game, head);
+
+    // Cells less than limit ahead of the head are free: the body lies at most farthest behind it
+    int farthest = 0;
+    for (int i = length - 1 - autopilot->cycle_unordered; i < length; i++) {
+        int behind = cycle_behind(autopilot, cells, head, board_index(board, snake_segment(snake, i)));
+        if (behind > farthest) {
+            farthest = behind;
+        }
+    }
+    int limit = cells - farthest;
+
+    // Skip up to the apple, or as far as is safe while it lies among the body
+    int target = 1;
+    if (!game->apple.eaten) {
+        int apple_ahead = cycle_behind(autopilot, cells, board_index(board, game->apple.pos), head);
+        target = apple_ahead < limit ? apple_ahead : limit - 1;
+    }
+
+    int x = head % cols;
+    int neighbours[4] = {
+            [LEFT] = x > 0 ? head - 1 : NO_CELL,
+            [RIGHT] = x < cols - 1 ? head + 1 : NO_CELL,
+            [UP] = head >= cols ? head - cols : NO_CELL,
+            [DOWN] = head < cells - cols ? head + cols : NO_CELL,
+    };
+    int best = NO_CELL;
+    int best_ahead = 0;
+
+    for (int d = 0; d < 4; d++) {
+        int n = neighbours[d];
+        if (n == NO_CELL) {
+            continue;
+        }
+
+        // The tail may be followed when it is the segment farthest behind, it leaves this tick;
+        // a snake of two would be turning back on itself
+        int ahead = cycle_behind(autopilot, cells, n, head);
+        if (ahead > limit || (ahead == limit && (n != tail || length <= 2))) {
+            continue;
+        }
+
+        // Prefer the farthest move up to the target, then the nearest one past it
+        bool better = best == NO_CELL ||
+                      (ahead <= target ? best_ahead > target || ahead > best_ahead : best_ahead > target && ahead < best_ahead);
+        if (better) {
+            best = n;
+            best_ahead = ahead;
+        }
+    }
+
+    if (best == NO_CELL) {
+        autopilot->cycle_next = NO_CELL;
+        return autopilot_decide(autopilot, game);
+    }
+
+    autopilot->cycle_next = best;
+    autopilot->cycle_length = length;
+
+    if (best == head - 1) {
+        return LEFT;
+    }
+    if (best == head + 1) {
+        return RIGHT;
+    }
+    return best < head ? UP : DOWN;
+}
@@ -0,0 +1,112 @@
+#include "../include//input.h"
+
+/**
+ * @brief Checks whether two directions point opposite ways.
+ */
+static bool opposite(Dir a, Dir b) {
+    return (a == LEFT && b == RIGHT) || (a == RIGHT && b == LEFT) ||
+           (a == UP && b == DOWN) || (a == DOWN && b == UP);
+}
+
+/**
+ * @brief Initializes an empty input queue and resets its latency statistics.
+ *
+ * @param input A pointer to the InputQueue struct to initialize.
+ */
+void init_input_queue(InputQueue *input) {
+    clear_input_queue(input);
+    input->latency_total = 0.0;
+    input->latency_max = 0.0;
+    input->latency_samples = 0;
+}
+
+/**
+ * @brief Drops all queued turns, keeping the latency statistics.
+ *
+ * @param input A pointer to the InputQueue struct to clear.
+ */
+void clear_input_queue(InputQueue *input) {
+    input->first = 0;
+    input->count = 0;
+}
+
+/**
+ * @brief Queues a turn pressed by the player.
+ *
+ * The turn is checked against the direction the snake will have when the turn is applied,
+ * that is the last queued turn or, if the queue is empty, the snake's current direction.
+ * Reversing into the body and repeating the same direction are ignored, as are presses
+ * that arrive while the queue is full.
+ *
+ * @param input A pointer to the InputQueue struct.
+ * @param snake A pointer to the Snake struct the turn is meant for.
+ * @param dir The direction pressed.
+ * @param now The time of the key press, in seconds.
+ *
+ * @return true if the turn was queued, false if it was ignored.
+ */
+bool push_turn(InputQueue *input, const Snake *snake, Dir dir, double now) {
+    Dir last = snake->direction;
+    bool moving = snake->has_moved;
+
+    if (input->count > 0) {
+        last = input->turns[(input->first + input->count - 1) % INPUT_QUEUE_SIZE];
+        moving = true;
+    }
+
+    // The first press only has to avoid reversing; afterwards, repeating the direction does nothing
+    if (opposite(dir, last) || (moving && dir == last) || input->count == INPUT_QUEUE_SIZE) {
+        return false;
+    }
+
+    int slot = (input->first + input->count) % INPUT_QUEUE_SIZE;
+    input->turns[slot] = dir;
+    input->pressed_at[slot] = now;
+    input->count++;
+
+    return true;
+}
+
+/**
+ * @brief Applies the oldest queued turn to the snake, if any.
+ *
+ * Meant to be called once per simulation tick, right before the tick moves the snake.
+ * The time between the key press and now is recorded as the turn's input-to-move latency.
+ *
+ * @param input A pointer to the InputQueue struct.
+ * @param snake A pointer to the Snake struct to turn.
+ * @param now The time of the tick, in seconds.
+ *
+ * @return true if a turn was applied, false if the queue was empty.
+ */
+bool apply_turn(InputQueue *input, Snake *snake, double now) {
+    if (input->count == 0) {
+        return false;
+    }
+
+    snake->direction = input->turns[input->first];
+    snake->has_moved = true;
+
+    double latency = now - input->pressed_at[input->first];
+    input->latency_total += latency;
+    input->latency_samples++;
+    if (latency > input->latency_max) {
+        input->latency_max = latency;
+    }
+
+    input->first = (input->first + 1) % INPUT_QUEUE_SIZE;
+    input->count--;
+
+    return true;
+}
+
+/**
+ * @brief Returns the average input-to-move latency of the applied turns.
+ *
+ * @param input A pointer to the InputQueue struct.
+ *
+ * @return The average latency in seconds, or 0 if no turn has been applied yet.
+ */
+double average_input_latency(const InputQueue *input) {
+    return input->latency_samples > 0 ? input->latency_total / input->latency_samples : 0.0;
+}
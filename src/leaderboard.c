@@ -0,0 +1,322 @@
+#include "../include//leaderboard.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+
+#include <io.h>
+#include <windows.h>
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+#define LEADERBOARD_READ_WARNING "WARNING: Leaderboard %s is invalid, ignoring it\n"
+#define LEADERBOARD_WRITE_WARNING "WARNING: Error while writing leaderboard %s\n"
+
+/**
+ * @brief Computes the FNV-1a checksum of the entry count and the valid entries.
+ *
+ * @param file The leaderboard file to checksum.
+ *
+ * @return The 32-bit checksum.
+ */
+static uint32_t leaderboard_checksum(const LeaderboardFile *file) {
+    uint32_t hash = 2166136261u;
+    const unsigned char *bytes = (const unsigned char *) &file->count;
+
+    for (size_t i = 0; i < sizeof(file->count); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+
+    bytes = (const unsigned char *) file->entries;
+    for (size_t i = 0; i < file->count * sizeof(LeaderboardEntry); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Checks that a mapped file is a complete, uncorrupted leaderboard.
+ */
+static bool leaderboard_valid(const LeaderboardFile *file, size_t size) {
+    return size == sizeof(LeaderboardFile) &&
+           file->magic == LEADERBOARD_MAGIC &&
+           file->version == LEADERBOARD_VERSION &&
+           file->count <= LEADERBOARD_SIZE &&
+           file->checksum == leaderboard_checksum(file);
+}
+
+#ifdef _WIN32
+
+/**
+ * @brief Loads a whole file into memory. There is no mmap on Windows, the file is tiny anyway.
+ *
+ * @return The file contents, or NULL if the file does not exist. *exists tells a missing file from an empty one.
+ */
+static void *map_file(const char *path, size_t *size, bool *exists) {
+    FILE *f = fopen(path, "rb");
+
+    *exists = f != NULL;
+    if (f == NULL) {
+        return NULL;
+    }
+
+    void *data = malloc(sizeof(LeaderboardFile));
+    *size = data != NULL ? fread(data, 1, sizeof(LeaderboardFile), f) : 0;
+    fclose(f);
+
+    return data;
+}
+
+static void unmap_file(const void *data, size_t size) {
+    (void) size;
+    free((void *) data);
+}
+
+/**
+ * @brief Writes a file so that a crash leaves either the old or the new contents.
+ *
+ * The data is written to a temporary file, committed to disk and moved over the target.
+ */
+static bool write_file_atomic(const char *path, const void *data, size_t size) {
+    char tmp_path[FILENAME_MAX];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE *f = fopen(tmp_path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+
+    bool ok = fwrite(data, 1, size, f) == size && fflush(f) == 0 && _commit(_fileno(f)) == 0;
+    fclose(f);
+
+    if (!ok || !MoveFileExA(tmp_path, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        remove(tmp_path);
+        return false;
+    }
+
+    return true;
+}
+
+#else
+
+/**
+ * @brief Maps a whole file read-only into memory.
+ *
+ * @return The mapping, or NULL if the file does not exist or cannot be mapped. *exists tells a missing file
+ *         from one that could not be mapped.
+ */
+static void *map_file(const char *path, size_t *size, bool *exists) {
+    int fd = open(path, O_RDONLY);
+
+    *exists = fd != -1;
+    if (fd == -1) {
+        return NULL;
+    }
+
+    void *data = NULL;
+    struct stat st;
+
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        data = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = NULL;
+        } else {
+            *size = (size_t) st.st_size;
+        }
+    }
+
+    close(fd);
+
+    return data;
+}
+
+static void unmap_file(const void *data, size_t size) {
+    munmap((void *) data, size);
+}
+
+/**
+ * @brief Writes a file so that a crash leaves either the old or the new contents.
+ *
+ * The data is written to a temporary file, fsync'ed and renamed over the target. The directory is
+ * fsync'ed too so that the rename itself survives a power loss.
+ */
+static bool write_file_atomic(const char *path, const void *data, size_t size) {
+    char tmp_path[FILENAME_MAX];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd == -1) {
+        return false;
+    }
+
+    const char *bytes = data;
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = write(fd, bytes + written, size - written);
+        if (n <= 0) {
+            break;
+        }
+        written += (size_t) n;
+    }
+
+    bool ok = written == size && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+
+    if (!ok || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return false;
+    }
+
+    char dir_path[FILENAME_MAX];
+    snprintf(dir_path, sizeof(dir_path), "%s", path);
+    char *slash = strrchr(dir_path, '/');
+    if (slash != NULL) {
+        slash[1] = '\0';
+    } else {
+        snprintf(dir_path, sizeof(dir_path), ".");
+    }
+
+    int dir_fd = open(dir_path, O_RDONLY);
+    if (dir_fd != -1) {
+        fsync(dir_fd);
+        close(dir_fd);
+    }
+
+    return true;
+}
+
+#endif
+
+/**
+ * @brief Opens the leaderboard file and maps it into memory.
+ *
+ * A missing file is not an error, the leaderboard is simply empty. A file that fails validation
+ * (wrong size, magic, version or checksum) is ignored and flagged as invalid; it is replaced by
+ * the next successful leaderboard_insert().
+ *
+ * @param leaderboard A pointer to the Leaderboard struct to fill in.
+ * @param path The path of the leaderboard file.
+ *
+ * @return false if the file exists but is invalid, true otherwise.
+ */
+bool open_leaderboard(Leaderboard *leaderboard, const char *path) {
+    size_t size = 0;
+    bool exists = false;
+    void *data = map_file(path, &size, &exists);
+
+    leaderboard->file = NULL;
+    leaderboard->mapped_size = 0;
+    leaderboard->invalid = false;
+
+    if (data != NULL && leaderboard_valid(data, size)) {
+        leaderboard->file = data;
+        leaderboard->mapped_size = size;
+        return true;
+    }
+
+    if (data != NULL) {
+        unmap_file(data, size);
+    }
+
+    if (exists) {
+        fprintf(stderr, LEADERBOARD_READ_WARNING, path);
+        leaderboard->invalid = true;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Unmaps the leaderboard file.
+ *
+ * @param leaderboard A pointer to the Leaderboard struct to close.
+ */
+void close_leaderboard(Leaderboard *leaderboard) {
+    if (leaderboard->file != NULL) {
+        unmap_file(leaderboard->file, leaderboard->mapped_size);
+    }
+
+    leaderboard->file = NULL;
+    leaderboard->mapped_size = 0;
+}
+
+/**
+ * @brief Returns the number of entries on the leaderboard.
+ */
+int leaderboard_count(const Leaderboard *leaderboard) {
+    return leaderboard->file != NULL ? (int) leaderboard->file->count : 0;
+}
+
+/**
+ * @brief Returns the entry at the given rank, 0 being the best game.
+ *
+ * @return A pointer into the mapped file, or NULL if there is no such entry.
+ */
+const LeaderboardEntry *leaderboard_entry(const Leaderboard *leaderboard, int rank) {
+    if (rank < 0 || rank >= leaderboard_count(leaderboard)) {
+        return NULL;
+    }
+
+    return &leaderboard->file->entries[rank];
+}
+
+/**
+ * @brief Inserts a finished game into the leaderboard and writes it to disk atomically.
+ *
+ * Entries are ordered by score, best first; a tie keeps the older entry ahead. If the game does not
+ * make it into the top LEADERBOARD_SIZE, nothing is written. On success the new file is mapped in
+ * place of the old one.
+ *
+ * @param leaderboard A pointer to the open Leaderboard.
+ * @param path The path of the leaderboard file.
+ * @param entry The game to insert.
+ *
+ * @return false if the leaderboard file could not be written, true otherwise.
+ */
+bool leaderboard_insert(Leaderboard *leaderboard, const char *path, const LeaderboardEntry *entry) {
+    LeaderboardFile file;
+    memset(&file, 0, sizeof(file));
+    file.magic = LEADERBOARD_MAGIC;
+    file.version = LEADERBOARD_VERSION;
+
+    int count = leaderboard_count(leaderboard);
+    if (count > 0) {
+        memcpy(file.entries, leaderboard->file->entries, count * sizeof(LeaderboardEntry));
+    }
+
+    int rank = count;
+    while (rank > 0 && file.entries[rank - 1].score < entry->score) {
+        rank--;
+    }
+
+    if (rank >= LEADERBOARD_SIZE) {
+        return true;
+    }
+
+    int moved = (count < LEADERBOARD_SIZE ? count : LEADERBOARD_SIZE - 1) - rank;
+    memmove(&file.entries[rank + 1], &file.entries[rank], moved * sizeof(LeaderboardEntry));
+    file.entries[rank] = *entry;
+    file.entries[rank].reserved = 0;
+    file.count = count < LEADERBOARD_SIZE ? count + 1 : LEADERBOARD_SIZE;
+    file.checksum = leaderboard_checksum(&file);
+
+    if (!write_file_atomic(path, &file, sizeof(file))) {
+        fprintf(stderr, LEADERBOARD_WRITE_WARNING, path);
+        return false;
+    }
+
+    close_leaderboard(leaderboard);
+    open_leaderboard(leaderboard, path);
+
+    return true;
+}
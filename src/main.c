@@ -1,15 +1,161 @@
-#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "raylib.h"
 #include "../include//score.h"
 #include "../include//controllers.h"
+#include "../include//render.h"
 #include "../include//window.h"
 #include "../include//apple.h"
+#include "../include//arena_mode.h"
+#include "../include//assets.h"
+#include "../include//clock.h"
+#include "../include//profiler.h"
+#include "../include//replay.h"
 
+#define USAGE_MSG "Usage: %s [--cols N] [--rows N] [--speed TICKS_PER_SECOND] [--seed N] [--replay FILE] [--snakes N [--players 0-2] [--apples N]]\n"
+#define BOARD_SIZE_ERROR "ERROR: Board size must be between %d and %d cells per side\n"
+#define REPLAY_PATH_SIZE 64
 
 static void draw_overlay(Color color) {
     DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, color);
 }
 
+/**
+ * @brief Parses the command line into the game settings.
+ *
+ * Recognizes --cols, --rows and --speed for every mode, and --snakes, --players and --apples for
+ * the multi-snake mode, each followed by a non-negative integer. Settings that are not given keep
+ * their value, 0 meaning the default. --seed replays the game with that seed, --replay plays back
+ * a recorded game instead of letting the player play.
+ *
+ * @return false if an argument is unknown or malformed.
+ */
+static bool parse_args(int argc, char **argv, Game *game, ArenaOptions *arena, const char **replay_path) {
+    for (int i = 1; i < argc; i++) {
+        int *setting = NULL;
+
+        if (strcmp(argv[i], "--cols") == 0) {
+            setting = &game->cols;
+        } else if (strcmp(argv[i], "--rows") == 0) {
+            setting = &game->rows;
+        } else if (strcmp(argv[i], "--speed") == 0) {
+            setting = &game->tick_rate;
+        } else if (strcmp(argv[i], "--snakes") == 0) {
+            setting = &arena->snakes;
+        } else if (strcmp(argv[i], "--players") == 0) {
+            setting = &arena->players;
+        } else if (strcmp(argv[i], "--apples") == 0) {
+            setting = &arena->apples;
+        }
+
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            char *endptr;
+            game->seed = strtoull(argv[++i], &endptr, 10);
+            if (*endptr != '\0') {
+                return false;
+            }
+            continue;
+        }
+
+        if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            *replay_path = argv[++i];
+            continue;
+        }
+
+        if (setting == NULL || i + 1 >= argc) {
+            return false;
+        }
+
+        char *endptr;
+        long value = strtol(argv[++i], &endptr, 10);
+        if (*endptr != '\0' || value < 0 || value > BOARD_MAX_SIZE) {
+            return false;
+        }
+        *setting = (int) value;
+    }
+
+    return arena->players <= ARENA_MAX_PLAYERS;
+}
+
+/**
+ * @brief Plays the multi-snake mode instead of the single-player game.
+ *
+ * @param game The Game struct holding the board size and tick rate from the command line.
+ * @param options The multi-snake settings from the command line.
+ *
+ * @return 0 on successful execution, non-zero otherwise.
+ */
+static int play_arena(const Game *game, const ArenaOptions *options) {
+    Arena arena = {0};
+    int apples = options->apples > 0 ? options->apples : options->snakes * ARENA_APPLES_PER_SNAKE;
+
+    if (!init_arena(&arena, game->cols > 0 ? game->cols : DEFAULT_COLS, game->rows > 0 ? game->rows : DEFAULT_ROWS,
+                    options->snakes, options->players, apples, game->seed)) {
+        return 1;
+    }
+
+    Assets assets;
+    start_loading_assets(&assets);
+
+    SetConfigFlags(FLAG_VSYNC_HINT);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_TITLE);
+    set_render_board(arena.board.cols, arena.board.rows);
+
+    run_arena(&arena, &assets, game->tick_rate > 0 ? game->tick_rate : DEFAULT_TICK_RATE);
+
+    unload_grid();
+    unload_assets(&assets);
+
+    CloseWindow();
+
+    free_arena(&arena);
+
+    return 0;
+}
+
+/**
+ * @brief Writes the replay of a finished game to data/replays/<seed>.snrp.
+ *
+ * Nothing is written if the recording failed, as an incomplete replay would not play back the game.
+ *
+ * @param replay A pointer to the Replay that recorded the game.
+ * @param game A pointer to the finished game.
+ */
+static void save_game_replay(Replay *replay, const Game *game) {
+    char path[sizeof(REPLAY_DIR_PATH) + REPLAY_PATH_SIZE];
+
+    if (replay->failed) {
+        return;
+    }
+
+    finish_replay(replay, game);
+    ensure_dir_exists(REPLAY_DIR_PATH);
+    snprintf(path, sizeof(path), REPLAY_DIR_PATH "%llu.snrp", (unsigned long long) game->seed);
+    save_replay(replay, path);
+}
+
+/**
+ * @brief Starts the next game, or plays the replay again from the start.
+ *
+ * The new snake shares no segments with the old one, so its mesh is rebuilt rather than synced.
+ */
+static void restart(Game *game, InputQueue *input, Replay *replay, ReplayPlayer *player, SnapshotRing *snapshots,
+                    SnakeMesh *snake_mesh, bool replaying) {
+    if (replaying) {
+        setup_replay_game(replay, game);
+        start_playback(player, replay);
+    } else {
+        restart_game(game);
+        start_replay(replay, game);
+        clear_snapshot_ring(snapshots);
+        push_snapshot(snapshots, game);
+    }
+    clear_input_queue(input);
+    rebuild_snake_mesh(snake_mesh, &game->snake);
+}
+
 /**
  * @brief Main function of the game.
  *
@@ -17,88 +163,262 @@ static void draw_overlay(Color color) {
  * It then enters a game loop where it handles user input, updates the game state,
  * and renders the game graphics.
  *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments, see parse_args().
+ *
  * @return 0 on successful execution, non-zero otherwise.
  */
-int main() {
-    InitAudioDevice();
+int main(int argc, char **argv) {
+    double startup_begin = clock_now();
+
+    // Every game is reproducible from its seed, which is saved with its leaderboard entry
+    Game game = {0};
+    game.seed = (uint64_t) time(NULL);
+    ArenaOptions arena_options = {0, DEFAULT_ARENA_PLAYERS, 0};
+    const char *replay_path = NULL;
+    if (!parse_args(argc, argv, &game, &arena_options, &replay_path)) {
+        fprintf(stderr, USAGE_MSG, argv[0]);
+        return 1;
+    }
+
+    if (arena_options.snakes > 0)
+        return play_arena(&game, &arena_options);
+
+    // Games are recorded as they are played; with --replay, a recording is played back instead
+    Replay replay = {0};
+    ReplayPlayer player;
+    bool replaying = replay_path != NULL;
+
+    if (replaying) {
+        if (!load_replay(&replay, replay_path))
+            return 1;
+        setup_replay_game(&replay, &game);
+        start_playback(&player, &replay);
+    } else if (!init_game(&game)) {
+        fprintf(stderr, BOARD_SIZE_ERROR, BOARD_MIN_SIZE, BOARD_MAX_SIZE);
+        return 1;
+    } else {
+        start_replay(&replay, &game);
+    }
+
+    // Search buffers for the autopilot; games it played a part in stay off the leaderboard
+    Autopilot autopilot = {0};
+    bool autopilot_on = false;
+    bool assisted = false;
+    if (!replaying)
+        init_autopilot(&autopilot, game.board.cols, game.board.rows);
+
+    // The state after every tick of the last REWIND_SECONDS, for the rewind key
+    SnapshotRing snapshots = {0};
+    if (!replaying && init_snapshot_ring(&snapshots, game.board.cols, game.board.rows,
+                                         REWIND_SECONDS * game.tick_rate + 1))
+        push_snapshot(&snapshots, &game);
+
+    // Decode the embedded assets and bring up audio while the window opens
+    Assets assets;
+    start_loading_assets(&assets);
+
     ChangeDirectory(GetApplicationDirectory());
     init_score();
 
-    GameState state = PLAYING;
+    InputQueue input;
+    init_input_queue(&input);
 
-    Timer apple_spawn_delay;
-    apple_spawn_delay.lifetime = APPLE_SPAWN_DELAY;
-    apple_spawn_delay.active = false;
+    SnakeMesh snake_mesh;
+    init_snake_mesh(&snake_mesh);
 
-    Snake snake;
-    init_snake(&snake);
+    // Frames are paced by vsync; game speed is set by game.tick_rate alone
+    SetConfigFlags(FLAG_VSYNC_HINT);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_TITLE);
+    set_render_board(game.board.cols, game.board.rows);
 
-    Apple apple;
-    init_apple(&apple, &snake, &apple_spawn_delay);
-    apple.first_render = true;
-    apple.eaten = true;
+    bool first_frame = true;
+    double accumulator = 0.0;
+#ifdef SNAKE_PROFILE
+    bool show_profiler = false;
+#endif
 
-    SetRandomSeed((unsigned) time(NULL));
-    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_TITLE);
-    SetTargetFPS(20);
+    while (!WindowShouldClose()) {
+        PROFILE_BEGIN(PROFILE_FRAME);
 
-    apple.texture = LoadTexture(APPLE_TEXTURE_PATH);
-    apple.eating_sound = LoadSound(APPLE_SOUND_PATH);
+        // Run as many fixed-length simulation ticks as the elapsed frame time calls for
+        double frame_time = GetFrameTime();
+        if (frame_time > MAX_FRAME_TIME)
+            frame_time = MAX_FRAME_TIME;
 
-    SetSoundVolume(apple.eating_sound, 0.6f); // 0.0 - 1.0
+        PROFILE_BEGIN(PROFILE_INPUT);
+        if (game.state == PLAYING) {
+            handle_keys(&input, &game.snake, &game.state, &autopilot_on);
+        }
+#ifdef SNAKE_PROFILE
+        if (IsKeyPressed(PROFILE_KEY))
+            show_profiler = !show_profiler;
+#endif
+        PROFILE_END(PROFILE_INPUT);
+
+        PROFILE_BEGIN(PROFILE_UPDATE);
+        if (game.state == PLAYING) {
+            accumulator += frame_time;
+            bool rewinding = !replaying && IsKeyDown(REWIND_KEY);
+
+            while (game.state == PLAYING && accumulator >= tick_interval(&game)) {
+                accumulator -= tick_interval(&game);
+
+                // While the rewind key is held, the game runs backwards at the same speed
+                if (rewinding) {
+                    if (rewind_game(&game, &snapshots, &replay)) {
+                        rebuild_snake_mesh(&snake_mesh, &game.snake);
+                        clear_input_queue(&input);
+                    }
+                    continue;
+                }
+
+                Autopilot *pilot = autopilot_on && autopilot.cols > 0 ? &autopilot : NULL;
+                assisted |= pilot != NULL;
+
+                if (replaying) {
+                    update_replay(&game, &player, &assets);
+                } else if (update_game(&game, &input, pilot, &replay, &assets) & (GAME_EVENT_DIED | GAME_EVENT_WON)) {
+                    // Write the leaderboard and the replay once per game over, not every frame
+                    if (!assisted && game.snake.score > 0) {
+                        save_score(game.snake.score, game.snake.length, game.elapsed, game.seed);
+                        flush_scores();
+                    }
+                    save_game_replay(&replay, &game);
+                }
+                push_snapshot(&snapshots, &game);
+
+                // Follow the snake tick by tick so the mesh never needs a full rebuild
+                sync_snake_mesh(&snake_mesh, &game.snake);
+            }
+        } else {
+            accumulator = 0.0;
+        }
+        PROFILE_END(PROFILE_UPDATE);
+
+        // Fraction of the next tick already elapsed, used to draw the snake between ticks
+        float alpha = game.state == PLAYING ? (float) (accumulator / tick_interval(&game)) : 1.0f;
+
+        poll_assets(&assets);
+
+        handle_zoom();
+        update_camera(game.snake.prev_head, snake_head(&game.snake), alpha);
 
-    while (!WindowShouldClose()) {
         BeginDrawing();
         ClearBackground(RAYWHITE);
 
-        draw_grid(COLS, ROWS, CELL_WIDTH, CELL_HEIGHT);
+        // The board, through the camera; only what is on screen is submitted
+        begin_board_view();
+        PROFILE_BEGIN(PROFILE_GRID);
+        draw_grid();
+        PROFILE_END(PROFILE_GRID);
+        PROFILE_BEGIN(PROFILE_SNAKE);
+        draw_snake(&game.snake, &snake_mesh, alpha);
+        PROFILE_END(PROFILE_SNAKE);
+        PROFILE_BEGIN(PROFILE_APPLE);
+        if (game.state == PLAYING || game.state == PAUSE)
+            draw_apple(&game.apple, assets.apple_texture);  // hidden on the game over screens
+        PROFILE_END(PROFILE_APPLE);
+        end_board_view();
 
-        switch (state) {
+        PROFILE_BEGIN(PROFILE_HUD);
+        switch (game.state) {
             case PAUSE:
                 draw_overlay(PAUSE_OVERLAY);
-                draw_snake(&snake);          // snake's last position
-                spawn_apple(&apple, &snake); // apple's last position
 
-                draw_score(snake.score, load_highest_score());
+                draw_score(game.snake.score, load_highest_score());
 
                 DrawText(PAUSE_MSG, HALF_SCREEN_W - MeasureText(PAUSE_MSG, FONT_SIZE) / 2.0,
                          HALF_SCREEN_H - 35, FONT_SIZE, BLACK);
 
                 if (IsKeyPressed(KEY_ENTER))
-                    state = PLAYING;
+                    game.state = PLAYING;
                 break;
 
             case OVER:
-                draw_snake(&snake);
-                save_highest_score(snake.score);
-
                 DrawText(RESTART_MSG,
                          HALF_SCREEN_W - MeasureText(RESTART_MSG, FONT_SIZE) / 2.0,
                          HALF_SCREEN_H - 35, FONT_SIZE, RED);
+                draw_leaderboard(HALF_SCREEN_W - MeasureText(RESTART_MSG, FONT_SIZE) / 2.0, LEADERBOARD_POSY);
 
-                if (IsKeyPressed(KEY_ENTER))
-                    restart_game(&snake, &state);
+                if (IsKeyPressed(KEY_ENTER)) {
+                    restart(&game, &input, &replay, &player, &snapshots, &snake_mesh, replaying);
+                    assisted = false;
+                }
+                break;
+
+            case WON:
+                DrawText(WIN_MSG,
+                         HALF_SCREEN_W - MeasureText(WIN_MSG, FONT_SIZE) / 2.0,
+                         HALF_SCREEN_H - 35, FONT_SIZE, DARKGREEN);
+                draw_leaderboard(HALF_SCREEN_W - MeasureText(WIN_MSG, FONT_SIZE) / 2.0, LEADERBOARD_POSY);
+
+                if (IsKeyPressed(KEY_ENTER)) {
+                    restart(&game, &input, &replay, &player, &snapshots, &snake_mesh, replaying);
+                    assisted = false;
+                }
                 break;
 
             case PLAYING:
-                handle_keys(&snake, &state);
-                update_game(&snake, &apple, &state);
-                spawn_apple(&apple, &snake);
-                draw_score(snake.score, load_highest_score());
-                draw_timer(&apple.timer);
+                draw_score(game.snake.score, load_highest_score());
+                draw_timer(&game.apple.timer);
+                if (autopilot_on && autopilot.cols > 0)
+                    DrawText(AUTOPILOT_MSG, SCORE_POSX, SCORE_POSY + 102, SCORE_FONTSIZE, DARKBLUE);
                 break;
         }
+#ifdef SNAKE_PROFILE
+        if (show_profiler)
+            draw_profiler(PROFILE_POSX, PROFILE_POSY);
+#endif
+        PROFILE_END(PROFILE_HUD);
 
+        PROFILE_BEGIN(PROFILE_PRESENT);
         EndDrawing();
+        PROFILE_END(PROFILE_PRESENT);
+
+        if (first_frame) {
+            printf("INFO: Startup: %.1f ms to first frame\n", (clock_now() - startup_begin) * 1000.0);
+            first_frame = false;
+        }
+
+        PROFILE_END(PROFILE_FRAME);
     }
 
-    save_highest_score(snake.score);
+    if (!replaying && !assisted && (game.state == PLAYING || game.state == PAUSE) && game.snake.score > 0)
+        save_score(game.snake.score, game.snake.length, game.elapsed, game.seed);
+    close_score();
 
-    UnloadTexture(apple.texture);
-    UnloadSound(apple.eating_sound);
+    if (input.latency_samples > 0)
+        printf("INFO: Input-to-move latency: avg %.1f ms, max %.1f ms over %d turns\n",
+               average_input_latency(&input) * 1000.0, input.latency_max * 1000.0, input.latency_samples);
+
+    if (autopilot.decisions > 0)
+        printf("INFO: Autopilot decision time: avg %.1f us, max %.1f us over %ld decisions, %ld without a safe path\n",
+               average_autopilot_latency(&autopilot) * 1e6, autopilot.max_time * 1e6, autopilot.decisions,
+               autopilot.tail_chases);
+
+#ifndef SNAKE_NO_AUDIO
+    if (assets.events.dropped > 0)
+        printf("INFO: Audio queue: %u sound events dropped while the dispatcher was behind\n", assets.events.dropped);
+#endif
+
+#ifdef SNAKE_PROFILE
+    ensure_dir_exists(SCORE_DIR_PATH);
+    if (export_profile_trace(PROFILE_TRACE_PATH))
+        printf("INFO: Frame profile written to %s\n", PROFILE_TRACE_PATH);
+#endif
+
+    unload_grid();
+    unload_assets(&assets);
 
     CloseWindow();
 
+    free_autopilot(&autopilot);
+    free_snake_mesh(&snake_mesh);
+    free_replay(&replay);
+    free_snapshot_ring(&snapshots);
+    free_game(&game);
+
     return 0;
 }
 
@@ -0,0 +1,160 @@
+#include "../include//policy.h"
+#include "../include//hamilton.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const Dir DIR_REVERSE[] = {[LEFT] = RIGHT, [RIGHT] = LEFT, [UP] = DOWN, [DOWN] = UP};
+static const Dir DIR_TURN_LEFT[] = {[LEFT] = DOWN, [RIGHT] = UP, [UP] = LEFT, [DOWN] = RIGHT};
+static const Dir DIR_TURN_RIGHT[] = {[LEFT] = UP, [RIGHT] = DOWN, [UP] = RIGHT, [DOWN] = LEFT};
+
+/**
+ * @brief Returns the neighbour of a cell in the given direction.
+ */
+static Cell step_cell(Cell cell, Dir direction) {
+    switch (direction) {
+        case LEFT:
+            cell.x -= 1;
+            break;
+        case RIGHT:
+            cell.x += 1;
+            break;
+        case UP:
+            cell.y -= 1;
+            break;
+        case DOWN:
+            cell.y += 1;
+            break;
+    }
+    return cell;
+}
+
+/**
+ * @brief Checks whether the head can move into a cell next tick without dying.
+ *
+ * The tail leaves its cell before the head moves, so following it is safe: the snake only keeps
+ * its tail when the head enters the apple's cell, which is never the tail's.
+ */
+static bool safe_cell(const Game *game, Cell cell) {
+    if (board_cell_free(&game->board, cell)) {
+        return true;
+    }
+
+    Cell tail = snake_tail(&game->snake);
+    return cell.x == tail.x && cell.y == tail.y;
+}
+
+/**
+ * @brief Goes straight, left or right at random, without looking.
+ */
+static Dir decide_random(const Game *game, Rng *rng, Autopilot *search) {
+    (void) search;
+    Dir current = game->snake.direction;
+    Dir options[] = {current, DIR_TURN_LEFT[current], DIR_TURN_RIGHT[current]};
+
+    return options[rng_range(rng, 0, 2)];
+}
+
+/**
+ * @brief Moves toward the apple, choosing among the cells that do not kill the snake next tick.
+ *
+ * Going straight wins ties, and when no cell is safe the snake goes straight.
+ */
+static Dir decide_greedy(const Game *game, Rng *rng, Autopilot *search) {
+    (void) rng;
+    (void) search;
+    Cell head = snake_head(&game->snake);
+    Cell target = game->apple.eaten ? head : game->apple.pos;
+    Dir current = game->snake.direction;
+    Dir options[] = {current, DIR_TURN_LEFT[current], DIR_TURN_RIGHT[current]};
+    Dir best_direction = current;
+    int best = -1;
+
+    for (int i = 0; i < 3; i++) {
+        Cell cell = step_cell(head, options[i]);
+        if (!safe_cell(game, cell)) {
+            continue;
+        }
+
+        int distance = abs(target.x - cell.x) + abs(target.y - cell.y);
+        if (best < 0 || distance < best) {
+            best = distance;
+            best_direction = options[i];
+        }
+    }
+
+    return best_direction;
+}
+
+/**
+ * @brief Follows shortest safe paths to the apple, see autopilot_decide().
+ */
+static Dir decide_autopilot(const Game *game, Rng *rng, Autopilot *search) {
+    (void) rng;
+    return autopilot_decide(search, game);
+}
+
+/**
+ * @brief Follows the board's Hamiltonian cycle with safe shortcuts, see hamilton_decide().
+ */
+static Dir decide_hamilton(const Game *game, Rng *rng, Autopilot *search) {
+    (void) rng;
+    return hamilton_decide(search, game);
+}
+
+static const Policy policies[] = {
+        {"random", decide_random},
+        {"greedy", decide_greedy},
+        {"autopilot", decide_autopilot},
+        {"hamilton", decide_hamilton},
+};
+
+/**
+ * @brief Looks a policy up by name.
+ *
+ * @param name The policy name, as given on the command line.
+ *
+ * @return The policy, or NULL if there is none with that name.
+ */
+const Policy *find_policy(const char *name) {
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (strcmp(policies[i].name, name) == 0) {
+            return &policies[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Writes the names of all policies, separated by '|', for usage messages.
+ *
+ * @param buffer The buffer to write to.
+ * @param size The size of the buffer.
+ */
+void list_policies(char *buffer, int size) {
+    int used = 0;
+    buffer[0] = '\0';
+
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]) && used < size; i++) {
+        used += snprintf(buffer + used, size - used, "%s%s", i > 0 ? "|" : "", policies[i].name);
+    }
+}
+
+/**
+ * @brief Lets a policy steer the snake for the next tick.
+ *
+ * A decision to reverse onto the body is ignored, as it would be for a player.
+ *
+ * @param game A pointer to the Game struct to steer.
+ * @param policy The policy that decides.
+ * @param rng The random number generator the policy draws from.
+ * @param search The search buffers the policy may use, initialized for the game's board size.
+ */
+void apply_policy(Game *game, const Policy *policy, Rng *rng, Autopilot *search) {
+    Dir direction = policy->decide(game, rng, search);
+
+    if (direction != DIR_REVERSE[game->snake.direction]) {
+        game->snake.direction = direction;
+    }
+    game->snake.has_moved = true;
+}
@@ -0,0 +1,153 @@
+#include "../include//profiler.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PROFILE_WRITE_WARNING "WARNING: Error while writing the profile trace %s\n"
+
+/**
+ * @brief One timed phase, as written to the trace file.
+ */
+typedef struct {
+    double start;   // Time of clock_now() when the phase began, in seconds.
+    float duration; // In seconds.
+    uint8_t phase;
+} ProfileEvent;
+
+/**
+ * @brief The last durations of one phase, a ring overwritten oldest first.
+ */
+typedef struct {
+    double samples[PROFILE_HISTORY];
+    int next;
+    int count;
+} ProfileHistory;
+
+static const char *PHASE_NAMES[PROFILE_PHASES] = {
+        [PROFILE_FRAME] = "frame",
+        [PROFILE_INPUT] = "input",
+        [PROFILE_UPDATE] = "update",
+        [PROFILE_GRID] = "grid",
+        [PROFILE_SNAKE] = "snake",
+        [PROFILE_APPLE] = "apple",
+        [PROFILE_HUD] = "hud",
+        [PROFILE_PRESENT] = "present",
+};
+
+// Both buffers are static, so recording a sample never allocates
+static ProfileHistory history[PROFILE_PHASES];
+static ProfileEvent trace[PROFILE_TRACE_EVENTS];
+static long trace_count;  // Events recorded since startup, trace holds the last PROFILE_TRACE_EVENTS.
+
+/**
+ * @brief Returns the name of a phase, as shown in the overlay and the trace.
+ */
+const char *profile_phase_name(ProfilePhase phase) {
+    return PHASE_NAMES[phase];
+}
+
+/**
+ * @brief Records one sample of a phase. Called by PROFILE_END().
+ *
+ * @param phase The phase that was timed.
+ * @param start The time the phase began, from clock_now().
+ * @param end The time the phase ended, from clock_now().
+ */
+void profile_record(ProfilePhase phase, double start, double end) {
+    ProfileHistory *h = &history[phase];
+    h->samples[h->next] = end - start;
+    h->next = (h->next + 1) % PROFILE_HISTORY;
+    if (h->count < PROFILE_HISTORY) {
+        h->count++;
+    }
+
+    ProfileEvent *event = &trace[trace_count % PROFILE_TRACE_EVENTS];
+    event->start = start;
+    event->duration = (float) (end - start);
+    event->phase = (uint8_t) phase;
+    trace_count++;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Computes the statistics of a phase over its recorded samples.
+ *
+ * @param phase The phase.
+ *
+ * @return The minimum, average and 99th percentile, all 0 if the phase has no sample yet.
+ */
+ProfileStats profile_stats(ProfilePhase phase) {
+    const ProfileHistory *h = &history[phase];
+    ProfileStats stats = {0};
+    double sorted[PROFILE_HISTORY];
+    double sum = 0.0;
+
+    if (h->count == 0) {
+        return stats;
+    }
+
+    for (int i = 0; i < h->count; i++) {
+        sorted[i] = h->samples[i];
+        sum += h->samples[i];
+    }
+    qsort(sorted, h->count, sizeof(double), compare_doubles);
+
+    stats.min = sorted[0] * 1000.0;
+    stats.avg = sum / h->count * 1000.0;
+    stats.p99 = sorted[(h->count * 99) / 100] * 1000.0;
+    stats.samples = h->count;
+
+    return stats;
+}
+
+/**
+ * @brief Writes the recorded phases as a Chrome trace, which chrome://tracing and Perfetto open.
+ *
+ * Every sample becomes a complete event on a single thread, so phases timed inside the frame
+ * show up nested under it. Times are in microseconds from the oldest event kept.
+ *
+ * @param path The path of the JSON file to write.
+ *
+ * @return false if the file could not be written.
+ */
+bool export_profile_trace(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, PROFILE_WRITE_WARNING, path);
+        return false;
+    }
+
+    long first = trace_count > PROFILE_TRACE_EVENTS ? trace_count - PROFILE_TRACE_EVENTS : 0;
+    double origin = trace_count > 0 ? trace[first % PROFILE_TRACE_EVENTS].start : 0.0;
+
+    // Events are recorded as they end, so a frame starts before the phases recorded ahead of it
+    for (long i = first; i < trace_count; i++) {
+        if (trace[i % PROFILE_TRACE_EVENTS].start < origin) {
+            origin = trace[i % PROFILE_TRACE_EVENTS].start;
+        }
+    }
+
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    for (long i = first; i < trace_count; i++) {
+        const ProfileEvent *event = &trace[i % PROFILE_TRACE_EVENTS];
+        fprintf(f, "{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f}%s\n",
+                PHASE_NAMES[event->phase], (event->start - origin) * 1e6, event->duration * 1e6,
+                i + 1 < trace_count ? "," : "");
+    }
+    fprintf(f, "]}\n");
+
+    bool ok = !ferror(f);
+    if (fclose(f) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        fprintf(stderr, PROFILE_WRITE_WARNING, path);
+    }
+
+    return ok;
+}
@@ -0,0 +1,388 @@
+#include "../include//render.h"
+#include "../include//render_backend.h"
+#include "../include//window.h"
+#include "rlgl.h"
+#include <stddef.h>
+
+// Size of the board being drawn, set by set_render_board()
+static int board_cols = 1, board_rows = 1;
+
+// The view into the board. World units are pixels at zoom 1, so a cell is CELL_SIZE units wide
+static Camera2D camera = {{0.0f, 0.0f}, {0.0f, 0.0f}, 0.0f, 1.0f};
+// Zoom range allowed on the current board
+static float min_zoom = 1.0f, max_zoom = MAX_CAMERA_ZOOM;
+// The board in world units, and the cells that intersect the screen; only these are submitted for drawing
+static RenderView board_view = {1, 1, CELL_SIZE, 0.0f, 0.0f, 0, 0, 0, 0};
+
+// One grid cell, drawn once into this texture and repeated over the visible part of the board
+static RenderTexture2D grid_tile;
+static bool grid_tile_loaded = false;
+
+/**
+ * @brief Returns the cell coordinate of a world coordinate, -1 for anything left of or above the board.
+ */
+static int world_to_cell(float v) {
+    return v < 0.0f ? -1 : (int) (v / CELL_SIZE);
+}
+
+/**
+ * @brief Recomputes the range of board cells visible through the camera.
+ */
+static void update_view(void) {
+    Vector2 top_left = GetScreenToWorld2D((Vector2) {0.0f, 0.0f}, camera);
+    Vector2 bottom_right = GetScreenToWorld2D((Vector2) {(float) GetScreenWidth(), (float) GetScreenHeight()}, camera);
+
+    board_view.x0 = world_to_cell(top_left.x);
+    board_view.y0 = world_to_cell(top_left.y);
+    board_view.x1 = world_to_cell(bottom_right.x);
+    board_view.y1 = world_to_cell(bottom_right.y);
+
+    board_view.x0 = board_view.x0 < 0 ? 0 : board_view.x0;
+    board_view.y0 = board_view.y0 < 0 ? 0 : board_view.y0;
+    board_view.x1 = board_view.x1 >= board_cols ? board_cols - 1 : board_view.x1;
+    board_view.y1 = board_view.y1 >= board_rows ? board_rows - 1 : board_view.y1;
+}
+
+/**
+ * @brief Checks whether any cell of a rectangle of cells, corners in any order, is on screen.
+ */
+static bool cells_visible(int x0, int y0, int x1, int y1) {
+    return (x0 < x1 ? x0 : x1) <= board_view.x1 && (x0 < x1 ? x1 : x0) >= board_view.x0 &&
+           (y0 < y1 ? y0 : y1) <= board_view.y1 && (y0 < y1 ? y1 : y0) >= board_view.y0;
+}
+
+/**
+ * @brief Returns the camera target along one axis for a followed point.
+ *
+ * The view is kept inside the board; if the board is smaller than the view along this axis,
+ * the board is centered instead.
+ */
+static float clamp_target(float followed, float board_extent, float half_view) {
+    if (board_extent <= 2.0f * half_view) {
+        return board_extent / 2.0f;
+    }
+    if (followed < half_view) {
+        return half_view;
+    }
+    if (followed > board_extent - half_view) {
+        return board_extent - half_view;
+    }
+    return followed;
+}
+
+/**
+ * @brief Sets the size of the board to draw and resets the camera.
+ *
+ * Boards that fit the window at the regular cell size are stretched over it, as before;
+ * larger boards are shown at the regular cell size, and the camera follows the snake's head.
+ * Must be called after the window is created, and again whenever the board size changes.
+ *
+ * @param cols The number of columns of the board.
+ * @param rows The number of rows of the board.
+ *
+ * @return This function does not return any value.
+ */
+void set_render_board(int cols, int rows) {
+    board_cols = cols;
+    board_rows = rows;
+    board_view.cols = cols;
+    board_view.rows = rows;
+
+    float fit_x = (float) GetScreenWidth() / (cols * CELL_SIZE);
+    float fit_y = (float) GetScreenHeight() / (rows * CELL_SIZE);
+    float fit = fit_x < fit_y ? fit_x : fit_y;
+
+    // Zooming out stops at the whole board, or at one pixel per cell on huge boards
+    min_zoom = fit < 1.0f ? fit : 1.0f;
+    min_zoom = min_zoom < MIN_CAMERA_ZOOM ? MIN_CAMERA_ZOOM : min_zoom;
+    max_zoom = fit > MAX_CAMERA_ZOOM ? fit : MAX_CAMERA_ZOOM;
+
+    camera.zoom = fit > 1.0f ? fit : 1.0f;
+    camera.offset = (Vector2) {GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
+    camera.target = (Vector2) {cols * CELL_SIZE / 2.0f, rows * CELL_SIZE / 2.0f};
+    update_view();
+}
+
+/**
+ * @brief Points the camera at a snake's head.
+ *
+ * The head is followed at its interpolated position, so the view scrolls smoothly between ticks.
+ * Must be called once per frame, before anything is drawn in the board view.
+ *
+ * @param prev_head The head's cell before the last tick.
+ * @param head The head's cell after the last tick.
+ * @param alpha Interpolation factor between the previous and the current tick, in [0, 1].
+ *
+ * @return This function does not return any value.
+ */
+void update_camera(Cell prev_head, Cell head, float alpha) {
+    float x = (prev_head.x + (head.x - prev_head.x) * alpha + 0.5f) * CELL_SIZE;
+    float y = (prev_head.y + (head.y - prev_head.y) * alpha + 0.5f) * CELL_SIZE;
+
+    camera.offset = (Vector2) {GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
+    camera.target.x = clamp_target(x, board_cols * CELL_SIZE, camera.offset.x / camera.zoom);
+    camera.target.y = clamp_target(y, board_rows * CELL_SIZE, camera.offset.y / camera.zoom);
+    update_view();
+}
+
+/**
+ * @brief Zooms the camera in (factor above 1) or out (factor below 1), within the board's zoom range.
+ *
+ * @param factor The factor to multiply the zoom by.
+ *
+ * @return This function does not return any value.
+ */
+void zoom_camera(float factor) {
+    camera.zoom *= factor;
+    camera.zoom = camera.zoom < min_zoom ? min_zoom : camera.zoom;
+    camera.zoom = camera.zoom > max_zoom ? max_zoom : camera.zoom;
+}
+
+/**
+ * @brief Starts drawing in board coordinates, through the camera.
+ *
+ * @return This function does not return any value.
+ */
+void begin_board_view(void) {
+    BeginMode2D(camera);
+}
+
+/**
+ * @brief Goes back to drawing in screen coordinates.
+ *
+ * @return This function does not return any value.
+ */
+void end_board_view(void) {
+    EndMode2D();
+}
+
+/**
+ * @brief Draws one grid cell into the tile texture the grid is made of.
+ */
+static void build_grid_tile(void) {
+    grid_tile = LoadRenderTexture((int) CELL_SIZE, (int) CELL_SIZE);
+    grid_tile_loaded = true;
+
+    BeginTextureMode(grid_tile);
+    ClearBackground(BLANK);
+    DrawRectangleLines(0, 0, (int) CELL_SIZE, (int) CELL_SIZE, LIGHTGRAY);
+    EndTextureMode();
+
+    SetTextureWrap(grid_tile.texture, TEXTURE_WRAP_REPEAT);
+}
+
+/**
+ * @brief Draws the grid over the visible part of the board.
+ *
+ * A single grid cell is drawn with raylib's DrawRectangleLines function into a small render
+ * target once, and the visible cells are covered with one textured quad that repeats it, so the
+ * grid costs a single draw call whatever the size of the board or of the window.
+ * When zoomed out so far that a cell is smaller than MIN_GRID_CELL_SIZE pixels, the lines would
+ * cover the whole board, so no grid is drawn.
+ * Must be called between begin_board_view() and end_board_view().
+ *
+ * @return This function does not return any value.
+ */
+void draw_grid(void) {
+    if (CELL_SIZE * camera.zoom < MIN_GRID_CELL_SIZE || board_view.x1 < board_view.x0 || board_view.y1 < board_view.y0) {
+        return;
+    }
+
+    if (!grid_tile_loaded) {
+        build_grid_tile();
+    }
+
+    float width = (board_view.x1 - board_view.x0 + 1) * CELL_SIZE;
+    float height = (board_view.y1 - board_view.y0 + 1) * CELL_SIZE;
+
+    // Render textures are stored upside down, hence the negative source height
+    Rectangle source = {0.0f, 0.0f, width, -height};
+    Rectangle dest = {board_view.x0 * CELL_SIZE, board_view.y0 * CELL_SIZE, width, height};
+    DrawTexturePro(grid_tile.texture, source, dest, (Vector2) {0.0f, 0.0f}, 0.0f, WHITE);
+}
+
+/**
+ * @brief Releases the grid tile. Must be called before the window is closed.
+ *
+ * @return This function does not return any value.
+ */
+void unload_grid(void) {
+    if (grid_tile_loaded) {
+        UnloadRenderTexture(grid_tile);
+        grid_tile_loaded = false;
+    }
+}
+
+/**
+ * @brief Adds an axis-aligned quad covering the board cells between two corners to the current batch.
+ *
+ * Corners may be fractional (interpolated) and given in any order. Must be called between
+ * rlBegin(RL_QUADS) and rlEnd().
+ */
+static void batch_cells(float x0, float y0, float x1, float y1, Color color) {
+    float left = (x0 < x1 ? x0 : x1) * CELL_SIZE;
+    float top = (y0 < y1 ? y0 : y1) * CELL_SIZE;
+    float right = ((x0 < x1 ? x1 : x0) + 1) * CELL_SIZE;
+    float bottom = ((y0 < y1 ? y1 : y0) + 1) * CELL_SIZE;
+
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlVertex2f(left, top);
+    rlVertex2f(left, bottom);
+    rlVertex2f(right, bottom);
+    rlVertex2f(right, top);
+}
+
+static void raylib_begin_rects(void *target, int count) {
+    (void) target;
+    rlCheckRenderBatchLimit(4 * count);
+    rlBegin(RL_QUADS);
+}
+
+static void raylib_fill_rect(void *target, float x, float y, float width, float height, RenderColor color) {
+    (void) target;
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlVertex2f(x, y);
+    rlVertex2f(x, y + height);
+    rlVertex2f(x + width, y + height);
+    rlVertex2f(x + width, y);
+}
+
+static void raylib_end_rects(void *target) {
+    (void) target;
+    rlEnd();
+}
+
+static void raylib_draw_image(void *target, const void *image, float x, float y, float width, float height,
+                              RenderColor tint) {
+    (void) target;
+    Texture2D texture = *(const Texture2D *) image;
+    Rectangle source_rect = {0, 0, (float) texture.width, (float) texture.height};
+    Rectangle dest_rect = {x, y, width, height};
+    DrawTexturePro(texture, source_rect, dest_rect, (Vector2) {0, 0}, 0, (Color) {tint.r, tint.g, tint.b, tint.a});
+}
+
+// Scene drawing through raylib: rectangles become one batch of quads, images are Texture2Ds
+static const RenderBackend raylib_backend = {
+        NULL,
+        raylib_begin_rects,
+        raylib_fill_rect,
+        raylib_end_rects,
+        raylib_draw_image,
+};
+
+/**
+ * @brief Draws the snake on the screen.
+ *
+ * The snake is drawn by draw_snake_scene() through raylib, as one batch of quads, and the same
+ * scene code draws it into a framebuffer in headless runs. Runs that lie entirely outside the
+ * camera's view are not submitted.
+ * Must be called between begin_board_view() and end_board_view().
+ *
+ * @param snake A pointer to the Snake struct that needs to be drawn.
+ * @param mesh A pointer to the SnakeMesh struct that mirrors the snake's body.
+ * @param alpha Interpolation factor between the previous and the current tick, in [0, 1].
+ */
+void draw_snake(const Snake *snake, SnakeMesh *mesh, float alpha) {
+    draw_snake_scene(&raylib_backend, &board_view, snake, mesh, alpha);
+}
+
+
+/**
+ * @brief Draws every snake of an arena.
+ *
+ * Segments are submitted as one batch of quads, one per visible segment; segments outside the
+ * camera's view are skipped. The player snakes get fixed colors, the AI snakes share a palette.
+ *
+ * @param arena A pointer to the Arena struct to draw.
+ */
+void draw_arena_snakes(const Arena *arena) {
+    static const Color player_colors[] = {LIME, SKYBLUE};
+    static const Color ai_colors[] = {GOLD, ORANGE, PINK, PURPLE, BEIGE, GRAY};
+    const int cols = arena->board.cols;
+
+    rlBegin(RL_QUADS);
+
+    for (int i = 0; i < arena->snake_count; i++) {
+        if (!arena->alive[i]) {
+            continue;
+        }
+
+        Color color = i < arena->player_count
+                      ? player_colors[i % (sizeof(player_colors) / sizeof(player_colors[0]))]
+                      : ai_colors[i % (sizeof(ai_colors) / sizeof(ai_colors[0]))];
+        Color head_color = {color.r / 2, color.g / 2, color.b / 2, 255};
+
+        for (int s = 0; s < arena->lengths[i]; s++) {
+            int32_t c = arena_segment(arena, i, s);
+            int x = c % cols;
+            int y = c / cols;
+
+            if (!cells_visible(x, y, x, y)) {
+                continue;
+            }
+
+            rlCheckRenderBatchLimit(4);
+            batch_cells((float) x, (float) y, (float) x, (float) y, s == 0 ? head_color : color);
+        }
+    }
+
+    rlEnd();
+}
+
+/**
+ * @brief Draws the apples of an arena.
+ *
+ * @param arena A pointer to the Arena struct to draw.
+ * @param texture The texture used to draw the apples; nothing is drawn while it is still loading.
+ */
+void draw_arena_apples(const Arena *arena, Texture2D texture) {
+    if (texture.id == 0) {
+        return;
+    }
+
+    for (int i = 0; i < arena->apple_count; i++) {
+        if (arena->apples[i] >= 0) {
+            draw_textured_rectangle(board_cell(&arena->board, arena->apples[i]), texture, WHITE);
+        }
+    }
+}
+
+/**
+ * @brief Draws a textured rectangle on the screen.
+ *
+ * This function uses raylib's DrawTexturePro function to draw a textured rectangle on the screen.
+ * The rectangle is positioned based on the provided position, and its size is one board cell. Cells outside the camera's view are skipped.
+ * The texture, color tint, and other rendering properties can be customized using the provided parameters.
+ *
+ * @param position The board cell the rectangle covers.
+ * @param texture The texture to be used for rendering the rectangle.
+ * @param tint The color tint to be applied to the texture.
+ *
+ * @return This function does not return any value.
+ */
+void draw_textured_rectangle(Cell position, Texture2D texture, Color tint) {
+    if (!cells_visible(position.x, position.y, position.x, position.y)) {
+        return;
+    }
+
+    Rectangle dest_rect = {(float) position.x * CELL_SIZE, (float) position.y * CELL_SIZE, CELL_SIZE, CELL_SIZE};
+    Rectangle source_rect = {0, 0, (float) texture.width, (float) texture.height};
+    Vector2 origin = {0, 0};
+    DrawTexturePro(texture, source_rect, dest_rect, origin, 0, tint);
+}
+
+
+/**
+ * @brief Draws the apple on the screen.
+ *
+ * The apple is hidden while it is eaten and waiting for its spawn timer to run out,
+ * and while its texture is still being loaded.
+ *
+ * @param apple Pointer to the apple object.
+ * @param texture The texture used to draw the apple.
+ *
+ * @return This function does not return any value.
+ */
+void draw_apple(const Apple *apple, Texture2D texture) {
+    draw_apple_scene(&raylib_backend, &board_view, apple, texture.id != 0 ? &texture : NULL);
+}
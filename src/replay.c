@@ -0,0 +1,308 @@
+#include "../include//replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_ALLOC_ERROR "ERROR: Out of memory while recording a replay, this game will not be saved as a replay\n"
+#define REPLAY_READ_WARNING "WARNING: Replay %s is invalid\n"
+#define REPLAY_WRITE_WARNING "WARNING: Error while writing replay %s\n"
+
+/**
+ * @brief Computes the FNV-1a checksum of the encoded turns.
+ */
+static uint32_t replay_checksum(const uint8_t *data, size_t size) {
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Starts recording a new game, reusing the buffer of the previous recording.
+ *
+ * Must be called right after init_game(). The Replay struct must be zero-initialized before the
+ * first call and released with free_replay().
+ *
+ * @param replay A pointer to the Replay struct to record into.
+ * @param game A pointer to the freshly initialized game.
+ */
+void start_replay(Replay *replay, const Game *game) {
+    memset(&replay->header, 0, sizeof(replay->header));
+    replay->header.magic = REPLAY_MAGIC;
+    replay->header.version = REPLAY_VERSION;
+    replay->header.seed = game->seed;
+    replay->header.cols = game->board.cols;
+    replay->header.rows = game->board.rows;
+    replay->header.tick_rate = game->tick_rate;
+
+    replay->last_turn_tick = 0;
+    replay->moving = false;
+    replay->failed = false;
+}
+
+/**
+ * @brief Appends a turn taken at the current tick. Called by record_tick().
+ *
+ * A replay missing a turn would play back a different game, so once a turn cannot be stored the
+ * recording stops and the replay is marked as failed until the next start_replay().
+ *
+ * @param replay A pointer to the Replay being recorded.
+ * @param direction The snake's new direction.
+ */
+void record_turn(Replay *replay, Dir direction) {
+    if (replay->failed) {
+        return;
+    }
+
+    // A varint takes at most 5 bytes for the 32-bit values stored here
+    if (replay->header.data_size + 5 > replay->capacity) {
+        size_t capacity = replay->capacity > 0 ? replay->capacity * 2 : REPLAY_INITIAL_CAPACITY;
+        uint8_t *data = realloc(replay->data, capacity);
+
+        if (data == NULL) {
+            fprintf(stderr, REPLAY_ALLOC_ERROR);
+            replay->failed = true;
+            return;
+        }
+        replay->data = data;
+        replay->capacity = capacity;
+    }
+
+    uint32_t value = ((replay->header.ticks - replay->last_turn_tick) << 2) | (uint32_t) direction;
+    while (value >= 0x80) {
+        replay->data[replay->header.data_size++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    replay->data[replay->header.data_size++] = (uint8_t) value;
+
+    replay->header.event_count++;
+    replay->last_turn_tick = replay->header.ticks;
+    replay->last_direction = direction;
+    replay->moving = true;
+}
+
+/**
+ * @brief Stores the outcome of the recorded game, to check playback against.
+ *
+ * @param replay A pointer to the Replay being recorded.
+ * @param game A pointer to the finished game.
+ */
+void finish_replay(Replay *replay, const Game *game) {
+    replay->header.score = game->snake.score;
+    replay->header.length = game->snake.length;
+    replay->header.checksum = replay_checksum(replay->data, replay->header.data_size);
+}
+
+/**
+ * @brief Releases the memory owned by a replay.
+ *
+ * @param replay A pointer to the Replay struct to release.
+ */
+void free_replay(Replay *replay) {
+    free(replay->data);
+    memset(replay, 0, sizeof(*replay));
+}
+
+/**
+ * @brief Writes a finished replay to a file.
+ *
+ * @param replay A pointer to the finished Replay.
+ * @param path The path of the replay file.
+ *
+ * @return false if the file could not be written.
+ */
+bool save_replay(const Replay *replay, const char *path) {
+    FILE *f = fopen(path, "wb");
+
+    bool ok = f != NULL &&
+              fwrite(&replay->header, sizeof(replay->header), 1, f) == 1 &&
+              (replay->header.data_size == 0 || fwrite(replay->data, replay->header.data_size, 1, f) == 1);
+
+    if (f != NULL && fclose(f) != 0) {
+        ok = false;
+    }
+
+    if (!ok) {
+        fprintf(stderr, REPLAY_WRITE_WARNING, path);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Reads a replay file written by save_replay().
+ *
+ * @param replay A pointer to the Replay struct to fill in; zero it before the first call.
+ * @param path The path of the replay file.
+ *
+ * @return false if the file cannot be read or fails validation (magic, version, size or checksum).
+ */
+bool load_replay(Replay *replay, const char *path) {
+    FILE *f = fopen(path, "rb");
+    ReplayHeader header;
+
+    bool ok = f != NULL && fread(&header, sizeof(header), 1, f) == 1 &&
+              header.magic == REPLAY_MAGIC && header.version == REPLAY_VERSION &&
+              header.cols >= BOARD_MIN_SIZE && header.cols <= BOARD_MAX_SIZE &&
+              header.rows >= BOARD_MIN_SIZE && header.rows <= BOARD_MAX_SIZE &&
+              header.tick_rate > 0;
+
+    uint8_t *data = NULL;
+    if (ok) {
+        data = malloc(header.data_size > 0 ? header.data_size : 1);
+        ok = data != NULL &&
+             (header.data_size == 0 || fread(data, header.data_size, 1, f) == 1) &&
+             replay_checksum(data, header.data_size) == header.checksum;
+    }
+
+    if (f != NULL) {
+        fclose(f);
+    }
+
+    if (!ok) {
+        free(data);
+        fprintf(stderr, REPLAY_READ_WARNING, path);
+        return false;
+    }
+
+    free(replay->data);
+    replay->header = header;
+    replay->failed = false;
+    replay->data = data;
+    replay->capacity = header.data_size;
+
+    return true;
+}
+
+/**
+ * @brief Initializes a game with the seed and settings of a replay.
+ *
+ * @param replay A pointer to the loaded Replay.
+ * @param game A pointer to the Game struct to initialize, see init_game().
+ */
+void setup_replay_game(const Replay *replay, Game *game) {
+    game->seed = replay->header.seed;
+    game->cols = replay->header.cols;
+    game->rows = replay->header.rows;
+    game->tick_rate = replay->header.tick_rate;
+    init_game(game);
+}
+
+/**
+ * @brief Decodes the next turn of a replay, if any.
+ */
+static void read_next_turn(ReplayPlayer *player) {
+    const Replay *replay = player->replay;
+    uint32_t value = 0;
+    int shift = 0;
+
+    player->has_next = false;
+    while (player->offset < replay->header.data_size && shift < 35) {
+        uint8_t byte = replay->data[player->offset++];
+        value |= (uint32_t) (byte & 0x7f) << shift;
+        shift += 7;
+
+        if (!(byte & 0x80)) {
+            player->next_tick += value >> 2;
+            player->next_direction = (Dir) (value & 3);
+            player->has_next = true;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Starts playing a replay back from its first tick.
+ *
+ * @param player A pointer to the ReplayPlayer struct to set up.
+ * @param replay A pointer to the loaded Replay to play.
+ */
+void start_playback(ReplayPlayer *player, const Replay *replay) {
+    player->replay = replay;
+    player->offset = 0;
+    player->tick = 0;
+    player->next_tick = 0;
+    read_next_turn(player);
+}
+
+/**
+ * @brief Cuts a recording back to its first ticks, dropping the turns made after them.
+ *
+ * Used when the game is rewound, so the recording keeps matching the game.
+ *
+ * @param replay A pointer to the Replay being recorded.
+ * @param ticks The number of ticks to keep, at most the number recorded.
+ */
+void rewind_replay(Replay *replay, uint32_t ticks) {
+    ReplayPlayer player;
+    size_t size = 0;
+    uint32_t count = 0;
+
+    replay->last_turn_tick = 0;
+    replay->moving = false;
+
+    start_playback(&player, replay);
+    while (player.has_next && player.next_tick < ticks) {
+        replay->last_turn_tick = player.next_tick;
+        replay->last_direction = player.next_direction;
+        replay->moving = true;
+        count++;
+        size = player.offset;
+        read_next_turn(&player);
+    }
+
+    replay->header.data_size = (uint32_t) size;
+    replay->header.event_count = count;
+    replay->header.ticks = ticks;
+}
+
+/**
+ * @brief Applies the recorded turn for the tick about to be simulated, if there is one.
+ *
+ * Takes the place of the player's input: call it once per tick, before tick_game().
+ *
+ * @param player A pointer to the ReplayPlayer.
+ * @param snake A pointer to the snake to steer.
+ *
+ * @return false once every recorded tick has been played back.
+ */
+bool playback_tick(ReplayPlayer *player, Snake *snake) {
+    if (player->tick >= player->replay->header.ticks) {
+        return false;
+    }
+
+    if (player->has_next && player->next_tick == player->tick) {
+        snake->direction = player->next_direction;
+        snake->has_moved = true;
+        read_next_turn(player);
+    }
+
+    player->tick++;
+    return true;
+}
+
+/**
+ * @brief Plays a replay back headless, at full simulation speed, and checks its outcome.
+ *
+ * @param replay A pointer to the loaded Replay.
+ * @param game A pointer to a Game struct to play in; zero it before the first call.
+ *
+ * @return true if the game ends with the recorded score and length after the recorded number of ticks.
+ */
+bool verify_replay(const Replay *replay, Game *game) {
+    ReplayPlayer player;
+
+    setup_replay_game(replay, game);
+    start_playback(&player, replay);
+
+    while (game->state == PLAYING && playback_tick(&player, &game->snake)) {
+        tick_game(game, tick_interval(game));
+    }
+
+    return player.tick == replay->header.ticks &&
+           game->snake.score == replay->header.score &&
+           game->snake.length == replay->header.length;
+}
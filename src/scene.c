@@ -0,0 +1,193 @@
+#include "../include//render_backend.h"
+#include "../include//window.h"
+#include <stddef.h>
+
+/**
+ * @brief Fits a whole board in a render target, centered, with square cells.
+ *
+ * This is the view the game starts with on boards that fit the window; headless renders always
+ * show the whole board.
+ *
+ * @param view A pointer to the RenderView to set.
+ * @param cols The number of columns of the board.
+ * @param rows The number of rows of the board.
+ * @param width The width of the target, in pixels.
+ * @param height The height of the target, in pixels.
+ */
+void fit_render_view(RenderView *view, int cols, int rows, int width, int height) {
+    float fit_x = (float) width / cols;
+    float fit_y = (float) height / rows;
+
+    view->cols = cols;
+    view->rows = rows;
+    view->cell_size = fit_x < fit_y ? fit_x : fit_y;
+    view->origin_x = (width - cols * view->cell_size) / 2.0f;
+    view->origin_y = (height - rows * view->cell_size) / 2.0f;
+    view->x0 = 0;
+    view->y0 = 0;
+    view->x1 = cols - 1;
+    view->y1 = rows - 1;
+}
+
+/**
+ * @brief Checks whether any cell of a rectangle of cells, corners in any order, is in view.
+ */
+static bool cells_in_view(const RenderView *view, int x0, int y0, int x1, int y1) {
+    return (x0 < x1 ? x0 : x1) <= view->x1 && (x0 < x1 ? x1 : x0) >= view->x0 &&
+           (y0 < y1 ? y0 : y1) <= view->y1 && (y0 < y1 ? y1 : y0) >= view->y0;
+}
+
+/**
+ * @brief Fills the board cells between two corners, which may be fractional and in any order.
+ */
+static void fill_cells(const RenderBackend *backend, const RenderView *view, float x0, float y0, float x1, float y1,
+                       RenderColor color) {
+    float left = view->origin_x + (x0 < x1 ? x0 : x1) * view->cell_size;
+    float top = view->origin_y + (y0 < y1 ? y0 : y1) * view->cell_size;
+    float right = view->origin_x + ((x0 < x1 ? x1 : x0) + 1) * view->cell_size;
+    float bottom = view->origin_y + ((y0 < y1 ? y1 : y0) + 1) * view->cell_size;
+
+    backend->fill_rect(backend->target, left, top, right - left, bottom - top, color);
+}
+
+/**
+ * @brief Draws the outline of every visible cell, as the game's grid tile does.
+ *
+ * Each cell is outlined on all four sides, so lines between cells are twice as thick as the
+ * board's border. Lines scale with the cells, and are left out when cells are smaller than
+ * MIN_GRID_CELL_SIZE pixels.
+ *
+ * @param backend The backend to draw with.
+ * @param view Where the board is on the target.
+ */
+void draw_grid_lines(const RenderBackend *backend, const RenderView *view) {
+    if (view->cell_size < MIN_GRID_CELL_SIZE || view->x1 < view->x0 || view->y1 < view->y0) {
+        return;
+    }
+
+    float cell = view->cell_size;
+    float line = cell / CELL_SIZE > 1.0f ? cell / CELL_SIZE : 1.0f;
+    float left = view->origin_x + view->x0 * cell;
+    float top = view->origin_y + view->y0 * cell;
+    float width = (view->x1 - view->x0 + 1) * cell;
+    float height = (view->y1 - view->y0 + 1) * cell;
+
+    backend->begin_rects(backend->target, 2 * (view->x1 - view->x0 + 1) + 2 * (view->y1 - view->y0 + 1));
+
+    for (int x = view->x0; x <= view->x1; x++) {
+        float cell_left = view->origin_x + x * cell;
+        backend->fill_rect(backend->target, cell_left, top, line, height, RENDER_LIGHTGRAY);
+        backend->fill_rect(backend->target, cell_left + cell - line, top, line, height, RENDER_LIGHTGRAY);
+    }
+    for (int y = view->y0; y <= view->y1; y++) {
+        float cell_top = view->origin_y + y * cell;
+        backend->fill_rect(backend->target, left, cell_top, width, line, RENDER_LIGHTGRAY);
+        backend->fill_rect(backend->target, left, cell_top + cell - line, width, line, RENDER_LIGHTGRAY);
+    }
+
+    backend->end_rects(backend->target);
+}
+
+/**
+ * @brief Draws the snake as a handful of rectangles.
+ *
+ * The body is taken from the snake's mesh, where each straight run of segments is a single
+ * rectangle, so a long snake costs a handful of rectangles instead of one per segment. The mesh is
+ * synced incrementally at the head and tail, not rebuilt. Runs that lie entirely out of view are
+ * skipped. The head is drawn in a different color than the body, and both turn red once the score
+ * reaches MIN_SCORE_FOR_RED_SNAKE.
+ *
+ * The simulation runs at a fixed tick rate while frames are rendered as fast as the display allows,
+ * so the head and the tail are drawn between their previous and current cells: alpha is the fraction
+ * of the current tick that has elapsed, 0 showing the previous tick and 1 the current one.
+ *
+ * @param backend The backend to draw with.
+ * @param view Where the board is on the target.
+ * @param snake A pointer to the Snake struct to draw.
+ * @param mesh A pointer to the SnakeMesh struct that mirrors the snake's body.
+ * @param alpha Interpolation factor between the previous and the current tick, in [0, 1].
+ */
+void draw_snake_scene(const RenderBackend *backend, const RenderView *view, const Snake *snake, SnakeMesh *mesh,
+                      float alpha) {
+    RenderColor snake_color = RENDER_LIME;
+    RenderColor head_color = RENDER_DARKGREEN;
+
+    if (snake->score >= MIN_SCORE_FOR_RED_SNAKE) {
+        snake_color = RENDER_RED;
+        head_color = RENDER_DARKRED;
+    }
+
+    // Check if snake length is valid to prevent potential segmentation faults
+    if (snake->body == NULL || snake->length <= 0 || snake->length > snake->capacity) {
+        return;
+    }
+
+    // Skip rendering if the snake is out of bounds (it just hit a wall)
+    Cell head = snake_head(snake);
+    Cell tail = snake_tail(snake);
+    if (!cell_in_bounds(head, view->cols, view->rows) ||
+        !cell_in_bounds(snake->prev_head, view->cols, view->rows) ||
+        !cell_in_bounds(snake->prev_tail, view->cols, view->rows)) {
+        return;
+    }
+
+    sync_snake_mesh(mesh, snake);
+
+    // Runs, plus the interpolated tail and head
+    backend->begin_rects(backend->target, mesh->count + 2);
+
+    for (int i = 0; i < mesh->count; i++) {
+        SnakeRun run = *snake_mesh_run(mesh, i);
+
+        if (!cells_in_view(view, run.from.x, run.from.y, run.to.x, run.to.y)) {
+            continue;
+        }
+
+        // The head cell is drawn separately, interpolated
+        if (i == mesh->count - 1) {
+            if (run.from.x == run.to.x && run.from.y == run.to.y) {
+                continue;
+            }
+            run.to.x -= (run.to.x > run.from.x) - (run.to.x < run.from.x);
+            run.to.y -= (run.to.y > run.from.y) - (run.to.y < run.from.y);
+        }
+
+        fill_cells(backend, view, (float) run.from.x, (float) run.from.y, (float) run.to.x, (float) run.to.y,
+                   snake_color);
+    }
+
+    // The tail slides out of the cell it left during the last tick
+    if (snake->length > 1) {
+        float x = snake->prev_tail.x + (tail.x - snake->prev_tail.x) * alpha;
+        float y = snake->prev_tail.y + (tail.y - snake->prev_tail.y) * alpha;
+        fill_cells(backend, view, x, y, x, y, snake_color);
+    }
+
+    // The head slides into the cell it entered during the last tick
+    float x = snake->prev_head.x + (head.x - snake->prev_head.x) * alpha;
+    float y = snake->prev_head.y + (head.y - snake->prev_head.y) * alpha;
+    fill_cells(backend, view, x, y, x, y, head_color);
+
+    backend->end_rects(backend->target);
+}
+
+/**
+ * @brief Draws the apple over its cell.
+ *
+ * The apple is hidden while it is eaten and waiting for its spawn timer to run out, and while
+ * there is no image to draw it with (the game's texture is still loading).
+ *
+ * @param backend The backend to draw with.
+ * @param view Where the board is on the target.
+ * @param apple A pointer to the apple.
+ * @param image The apple's image, in the backend's format, or NULL.
+ */
+void draw_apple_scene(const RenderBackend *backend, const RenderView *view, const Apple *apple, const void *image) {
+    if (apple->eaten || image == NULL || !cells_in_view(view, apple->pos.x, apple->pos.y, apple->pos.x, apple->pos.y)) {
+        return;
+    }
+
+    backend->draw_image(backend->target, image, view->origin_x + apple->pos.x * view->cell_size,
+                        view->origin_y + apple->pos.y * view->cell_size, view->cell_size, view->cell_size,
+                        RENDER_WHITE);
+}
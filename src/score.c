@@ -1,9 +1,13 @@
 #include "../include//score.h"
 #include "raylib.h"
+#include "../include//leaderboard.h"
+#include "../include//profiler.h"
 #include "../include//timer.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>
+#include <time.h>
 
 #ifdef _WIN32
 
@@ -12,6 +16,13 @@
 
 #endif
 
+// The leaderboard file, mapped into memory by init_score()
+static Leaderboard leaderboard;
+// The last finished game, kept in memory until flush_scores() writes it
+static LeaderboardEntry pending_score;
+// Set when pending_score has not been written to the leaderboard yet
+static bool pending_score_dirty = false;
+
 /**
  * @brief Ensures that a directory exists. If it doesn't, it creates the directory.
  *
@@ -43,154 +54,176 @@ void ensure_dir_exists(const char *dir) {
 }
 
 /**
- * @brief Initializes the score file.
+ * @brief Reads the score from the legacy highest_score.txt file.
  *
- * This function opens the score file in append mode and checks if it's empty.
- * If it is, it writes the initial score "0" to the file.
- * If the file does not exist, it calls the ensure_dir_exists function to create the necessary directory,
- * then opens the file in append mode and writes the initial score "0" to it.
+ * This function opens the old single-score text file in read mode, reads the first line,
+ * and converts it to a long integer. It is only used once, to carry an existing high score
+ * over to the leaderboard.
  *
- * @return void
+ * @return The legacy highest score, or -1 if the file does not exist or is not a valid integer.
  *
- * @note This function uses the fopen, fseek, ftell, fgetc, fprintf, fclose, and ensure_dir_exists functions.
+ * @note This function uses the fopen, fgets, strtol, fclose functions.
  *
- * @warning This function does not handle errors in a robust manner. It simply prints a message
- *          to stdout and continues execution.
- *
- * @see ensure_dir_exists
  * @see https://en.cppreference.com/w/c/io/fopen
- * @see https://en.cppreference.com/w/c/io/fseek
- * @see https://en.cppreference.com/w/c/io/ftell
- * @see https://en.cppreference.com/w/c/io/fgetc
- * @see https://en.cppreference.com/w/c/io/fprintf
+ * @see https://en.cppreference.com/w/c/io/fgets
+ * @see https://en.cppreference.com/w/c/string/byte/strtol
  * @see https://en.cppreference.com/w/c/io/fclose
  */
-void init_score(void) {
-    FILE *f = fopen(SCORE_TXT_PATH, "a+");
-
-    if (f != NULL) {
-        fseek(f, 0, SEEK_END);
-        long size = ftell(f);
-
-        if (size == 0 || (size == 1 && fgetc(f) == '\n')) {
-            fprintf(f, "0");
-        }
-
-        fclose(f);
-        printf("INFO: %s initialized\n", SCORE_TXT_PATH);
-    } else {
-        ensure_dir_exists(SCORE_DIR_PATH);
+static int read_legacy_score(void) {
+    FILE *f = fopen(SCORE_TXT_PATH, "r");
 
-        f = fopen(SCORE_TXT_PATH, "a+");
+    if (f == NULL) {
+        return -1;
+    }
 
-        if (f != NULL) {
-            fseek(f, 0, SEEK_END);
-            long size = ftell(f);
+    char buffer[100];
+    long score = -1;
 
-            if (size == 0 || (size == 1 && fgetc(f) == '\n')) {
-                fprintf(f, "0");
-            }
+    if (fgets(buffer, sizeof(buffer), f) != NULL) {
+        char *endptr;
+        score = strtol(buffer, &endptr, 10);
 
-            fclose(f);
-            printf("INFO: %s initialized\n", SCORE_TXT_PATH);
-        } else {
-            fprintf(stderr, IO_WARNING_1);
+        if (*endptr != '\n' && *endptr != '\0') {
+            score = -1;
         }
     }
+
+    fclose(f);
+
+    return (int) score;
 }
 
 
 /**
- * @brief Loads the highest score from the score file.
+ * @brief Initializes the leaderboard.
  *
- * This function opens the score file in read mode, reads the first line,
- * converts it to a long integer, and returns it as the highest score.
- * If the file does not exist or cannot be opened, it prints an error message to stderr,
- * returns 0, and continues execution.
- * If the first line in the file cannot be converted to a valid integer,
- * it prints an error message to stderr, sets the highest score to -1,
- * and continues execution.
+ * This function makes sure the data directory exists and maps the leaderboard file into memory.
+ * If there is no leaderboard yet but a legacy highest_score.txt is found, its score is imported
+ * as the first entry. After this, the leaderboard file is only written by flush_scores().
  *
- * @return The highest score as an integer. If the score file cannot be read or
- *         the first line cannot be converted to a valid integer, returns 0 or -1, respectively.
- *
- * @note This function uses the fopen, fgets, strtol, fprintf, fclose functions.
+ * @return void
  *
  * @warning This function does not handle errors in a robust manner. It simply prints a message
  *          to stderr and continues execution.
  *
- * @see https://en.cppreference.com/w/c/io/fopen
- * @see https://en.cppreference.com/w/c/io/fgets
- * @see https://en.cppreference.com/w/c/string/byte/strtol
- * @see https://en.cppreference.com/w/c/io/fprintf
- * @see https://en.cppreference.com/w/c/io/fclose
+ * @see ensure_dir_exists
+ * @see open_leaderboard
  */
-int load_highest_score(void) {
-    FILE *f = fopen(SCORE_TXT_PATH, "r");
+void init_score(void) {
+    ensure_dir_exists(SCORE_DIR_PATH);
 
-    if (f == NULL) {
+    if (!open_leaderboard(&leaderboard, SCORE_DB_PATH)) {
         fprintf(stderr, IO_WARNING_2);
-        return 0;
+        return;
     }
 
-    char buffer[100];
-    if (fgets(buffer, sizeof(buffer), f) == NULL) {
-        fprintf(stderr, IO_WARNING_2);
-        fclose(f);
-        return 0;
-    }
+    if (leaderboard_count(&leaderboard) == 0) {
+        int legacy_score = read_legacy_score();
 
-    char *endptr;
-    long highest_score = strtol(buffer, &endptr, 10);
+        if (legacy_score > 0) {
+            LeaderboardEntry entry = {0};
+            entry.score = legacy_score;
+            entry.timestamp = (int64_t) time(NULL);
 
-    if (*endptr != '\n' && *endptr != '\0') {
-        fprintf(stderr, IO_WARNING_2);
-        highest_score = -1;
+            if (!leaderboard_insert(&leaderboard, SCORE_DB_PATH, &entry)) {
+                fprintf(stderr, IO_WARNING_1);
+                return;
+            }
+            printf("INFO: %s imported into %s\n", SCORE_TXT_PATH, SCORE_DB_PATH);
+        }
     }
 
-    fclose(f);
+    printf("INFO: %s initialized\n", SCORE_DB_PATH);
+}
+
+
+/**
+ * @brief Returns the highest score.
+ *
+ * The score is served from the mapped leaderboard and the in-memory pending game, so this is
+ * cheap enough to call every frame.
+ *
+ * @return The highest score as an integer, or -1 if the leaderboard file is invalid
+ *         and no game has been saved since.
+ *
+ * @see init_score
+ */
+int load_highest_score(void) {
+    const LeaderboardEntry *best = leaderboard_entry(&leaderboard, 0);
+    int highest = best != NULL ? best->score : (leaderboard.invalid ? -1 : 0);
 
-    return (int) highest_score;
+    if (pending_score_dirty && pending_score.score > highest) {
+        highest = pending_score.score;
+    }
+
+    return highest;
 }
 
 
 /**
- * @brief Saves the highest score to the score file.
+ * @brief Records a finished game for the leaderboard.
  *
- * This function compares the given score with the highest score loaded from the file.
- * If the given score is higher, it overwrites the content of the score file with the new score.
- * If the score file cannot be opened for writing, it prints an error message to stderr.
+ * This function only keeps the game in memory and marks it dirty;
+ * the leaderboard file is written later by flush_scores().
+ * If several games are saved between two flushes, the best one is kept.
  *
- * @param score The current score to be saved.
+ * @param score The score of the game.
+ * @param length The length of the snake at the end of the game.
+ * @param duration The duration of the game, in seconds.
+ * @param seed The seed of the game's random number generator.
  *
  * @return void
  *
- * @note This function uses the fopen, fprintf, fclose, load_highest_score functions.
+ * @see flush_scores
+ */
+void save_score(int score, int length, double duration, uint64_t seed) {
+    if (pending_score_dirty && pending_score.score >= score) {
+        return;
+    }
+
+    pending_score.score = score;
+    pending_score.length = length;
+    pending_score.duration_ms = (uint32_t) (duration * 1000.0);
+    pending_score.reserved = 0;
+    pending_score.seed = seed;
+    pending_score.timestamp = (int64_t) time(NULL);
+    pending_score_dirty = true;
+}
+
+
+/**
+ * @brief Writes the pending game to the leaderboard file if there is one.
  *
- * @warning This function does not handle errors in a robust manner. It simply prints a message
- *          to stderr and continues execution.
+ * This function is meant to be called once per game over and at shutdown, not every frame.
+ * The file is replaced atomically, see leaderboard_insert(). If it cannot be written, an error
+ * message is printed to stderr and the game stays pending so the next flush tries again.
  *
- * @see load_highest_score
- * @see https://en.cppreference.com/w/c/io/fopen
- * @see https://en.cppreference.com/w/c/io/fprintf
- * @see https://en.cppreference.com/w/c/io/fclose
+ * @return void
+ *
+ * @see leaderboard_insert
  */
-void save_highest_score(int score) {
-    int highest = load_highest_score();
-
-    FILE *f = fopen(SCORE_TXT_PATH, "w");
+void flush_scores(void) {
+    if (!pending_score_dirty) {
+        return;
+    }
 
-    if (f == NULL) {
+    if (!leaderboard_insert(&leaderboard, SCORE_DB_PATH, &pending_score)) {
         fprintf(stderr, IO_WARNING_3);
         return;
     }
 
-    if (score > highest)
-        fprintf(f, "%d", score);
-    else
-        fprintf(f, "%d", highest);
+    pending_score_dirty = false;
+}
 
-    fclose(f);
+
+/**
+ * @brief Flushes the pending game and unmaps the leaderboard.
+ *
+ * @return void
+ */
+void close_score(void) {
+    flush_scores();
+    close_leaderboard(&leaderboard);
 }
 
 /**
@@ -198,7 +231,7 @@ void save_highest_score(int score) {
  *
  * This function uses raylib's DrawText function to display the current score and the highest score
  * on the screen at the specified positions. If the highest score is invalid (i.e., -1), it displays
- * an error message indicating that the score file is invalid.
+ * an error message indicating that the leaderboard file is invalid.
  *
  * @param current_score The current score to be displayed.
  * @param highest_score The highest score to be displayed.
@@ -217,7 +250,7 @@ void draw_score(int current_score, int highest_score) {
              SCORE_POSY, SCORE_FONTSIZE, BLACK);
 
     if (highest_score == -1) {
-        DrawText(TextFormat("Highest Score: (-1) => \n\n%s is invalid", SCORE_TXT_PATH),
+        DrawText(TextFormat("Highest Score: (-1) => \n\n%s is invalid", SCORE_DB_PATH),
                  SCORE_POSX, SCORE_POSY + 30, SCORE_FONTSIZE, RED);
     } else {
         DrawText(TextFormat("Highest Score: %d", highest_score), SCORE_POSX,
@@ -225,6 +258,31 @@ void draw_score(int current_score, int highest_score) {
     }
 }
 
+/**
+ * @brief Draws the leaderboard on the screen.
+ *
+ * This function lists the best games, one per line, starting at the given position.
+ * Entries are read straight from the mapped leaderboard file, so drawing it costs no I/O.
+ *
+ * @param x The horizontal position of the leaderboard.
+ * @param y The vertical position of the first line.
+ *
+ * @return void
+ *
+ * @see https://www.raylib.com/cheatsheet/cheatsheet.html#DrawText
+ */
+void draw_leaderboard(int x, int y) {
+    DrawText("Leaderboard", x, y, SCORE_FONTSIZE, BLACK);
+
+    for (int rank = 0; rank < leaderboard_count(&leaderboard); rank++) {
+        const LeaderboardEntry *entry = leaderboard_entry(&leaderboard, rank);
+
+        DrawText(TextFormat("%2d. %4d  length %4d  %6.1fs", rank + 1, entry->score, entry->length,
+                            entry->duration_ms / 1000.0),
+                 x, y + (rank + 1) * LEADERBOARD_LINE_HEIGHT, SCORE_FONTSIZE, DARKGRAY);
+    }
+}
+
 /**
  * @brief Draws the elapsed time on the screen.
  *
@@ -248,3 +306,24 @@ void draw_timer(const Timer *timer) {
     sprintf(timer_text, "Elapsed Time: %.2f", timer->lifetime);
     DrawText(timer_text, 10, 80, 20, BLACK); // Adjust position as needed
 }
+
+#ifdef SNAKE_PROFILE
+
+/**
+ * @brief Draws the frame profiler's statistics, one phase per line, next to the elapsed time.
+ *
+ * @param x The horizontal position of the overlay.
+ * @param y The vertical position of the first line.
+ */
+void draw_profiler(int x, int y) {
+    DrawText("phase       min     avg     p99 ms", x, y, PROFILE_FONTSIZE, DARKGRAY);
+
+    for (int phase = 0; phase < PROFILE_PHASES; phase++) {
+        ProfileStats stats = profile_stats((ProfilePhase) phase);
+        DrawText(TextFormat("%-8s %6.2f  %6.2f  %6.2f", profile_phase_name((ProfilePhase) phase), stats.min,
+                            stats.avg, stats.p99),
+                 x, y + (phase + 1) * PROFILE_LINE_HEIGHT, PROFILE_FONTSIZE, DARKGRAY);
+    }
+}
+
+#endif
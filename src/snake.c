@@ -1,132 +1,161 @@
 #include "../include//snake.h"
-#include "../include//window.h"
-#include "raylib.h"
-// Make sure we have access to COLS and ROWS definitions
-#define COLS 32
-#define ROWS 24
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SNAKE_ALLOC_ERROR "ERROR: Out of memory while growing the snake\n"
 
 /**
  * @brief Initializes the snake game.
  *
  * This function sets the initial values for the snake's properties.
  * The length is set to 3 (considering the head), score is set to 0,
- * direction is set randomly, and the head position is set randomly within the game window.
+ * direction is set randomly, and the head position is set randomly in the middle of the board
+ * (columns 10-22 and rows 8-16 on the default 32x24 board).
  * The 'has_moved' flag is set to false to indicate that the snake has not moved yet.
  *
+ * The body buffer is allocated on the first call and reused on restarts, so the Snake struct
+ * must be zero-initialized before the first call and released with free_snake().
+ *
  * @param snake A pointer to the Snake struct that needs to be initialized.
+ * @param cols The number of columns of the board, at least BOARD_MIN_SIZE.
+ * @param rows The number of rows of the board, at least BOARD_MIN_SIZE.
+ * @param rng Pointer to the game's random number generator.
  */
-void init_snake(Snake *snake) {
+void init_snake(Snake *snake, int cols, int rows, Rng *rng) {
+    if (snake->body == NULL) {
+        snake->body = malloc(SNAKE_INITIAL_CAPACITY * sizeof(Cell));
+        if (snake->body == NULL) {
+            fprintf(stderr, SNAKE_ALLOC_ERROR);
+            exit(EXIT_FAILURE);
+        }
+        snake->capacity = SNAKE_INITIAL_CAPACITY;
+    }
+
     snake->length = 3; // Set initial length to 3 (head + 2 body segments)
     snake->score = 0;
-    snake->direction = (Dir)GetRandomValue(0, 3);
+    snake->direction = (Dir)rng_range(rng, 0, 3);
 
     // Set the head position randomly
-    snake->pos[0].x = (float)GetRandomValue(10, 22);
-    snake->pos[0].y = (float)GetRandomValue(8, 16);
+    Cell head;
+    head.x = rng_range(rng, cols * 5 / 16, cols * 11 / 16);
+    head.y = rng_range(rng, rows / 3, rows * 2 / 3);
 
     // Initialize body parts relative to the head based on initial direction
+    Cell step = {0, 0};
     switch (snake->direction) {
         case UP:
             // Body segments are below the head
-            snake->pos[1].x = snake->pos[0].x;
-            snake->pos[1].y = snake->pos[0].y + 1;
-            snake->pos[2].x = snake->pos[0].x;
-            snake->pos[2].y = snake->pos[0].y + 2;
+            step.y = 1;
             break;
         case DOWN:
             // Body segments are above the head
-            snake->pos[1].x = snake->pos[0].x;
-            snake->pos[1].y = snake->pos[0].y - 1;
-            snake->pos[2].x = snake->pos[0].x;
-            snake->pos[2].y = snake->pos[0].y - 2;
+            step.y = -1;
             break;
         case LEFT:
             // Body segments are to the right of the head
-            snake->pos[1].x = snake->pos[0].x + 1;
-            snake->pos[1].y = snake->pos[0].y;
-            snake->pos[2].x = snake->pos[0].x + 2;
-            snake->pos[2].y = snake->pos[0].y;
+            step.x = 1;
             break;
         case RIGHT:
             // Body segments are to the left of the head
-            snake->pos[1].x = snake->pos[0].x - 1;
-            snake->pos[1].y = snake->pos[0].y;
-            snake->pos[2].x = snake->pos[0].x - 2;
-            snake->pos[2].y = snake->pos[0].y;
+            step.x = -1;
             break;
         default:
             break;
     }
 
+    // The tail sits in slot 0 and the head in the last used slot
+    snake->head = snake->length - 1;
+    for (int i = 0; i < snake->length; i++) {
+        snake->body[snake->head - i].x = head.x + step.x * i;
+        snake->body[snake->head - i].y = head.y + step.y * i;
+    }
+
+    snake->prev_head = snake_head(snake);
+    snake->prev_tail = snake_tail(snake);
     snake->has_moved = false;
 }
 
-
+/**
+ * @brief Releases the body buffer of the snake.
+ *
+ * @param snake A pointer to the Snake struct to release.
+ */
+void free_snake(Snake *snake) {
+    free(snake->body);
+    snake->body = NULL;
+    snake->capacity = 0;
+    snake->length = 0;
+}
 
 /**
- * @brief Draws the snake on the screen.
+ * @brief Doubles the body buffer, unrolling the ring so the tail ends up in slot 0.
  *
- * This function draws the snake on the screen using raylib's DrawRectangle function.
- * The snake is drawn as a series of rectangles, with the head having a different color than the body.
- * If the snake's score is greater than or equal to MIN_SCORE_FOR_RED_SNAKE, the snake and its head are drawn in red.
- * The function ensures proper rendering by drawing the body segments and head in the correct order.
+ * @param snake A pointer to the Snake struct to grow.
  *
- * @param snake A pointer to the Snake struct that needs to be drawn.
+ * @return true if the buffer was grown, false if the allocation failed.
  */
-void draw_snake(Snake *snake) {
-    Vector2 *head = &snake->pos[0];
-    Color snake_color = LIME;
-    Color head_color = DARKGREEN;
-
-    if (snake->score >= MIN_SCORE_FOR_RED_SNAKE) {
-        snake_color = RED;
-        head_color = (Color) {204, 4, 4, 255}; // darker red
-    }
+static bool grow_body(Snake *snake) {
+    int capacity = snake->capacity * 2;
+    Cell *body = malloc(capacity * sizeof(Cell));
 
-    // Check if snake length is valid to prevent potential segmentation faults
-    if (snake->length <= 0 || snake->length > 100) {
-        return; // Invalid length
+    if (body == NULL) {
+        fprintf(stderr, SNAKE_ALLOC_ERROR);
+        return false;
     }
 
-    // Validate each snake position to prevent rendering issues
     for (int i = 0; i < snake->length; i++) {
-        float x = snake->pos[i].x;
-        float y = snake->pos[i].y;
+        body[snake->length - 1 - i] = snake_segment(snake, i);
+    }
 
-        // Skip rendering if position is out of bounds
-        if (x < 0 || x >= COLS || y < 0 || y >= ROWS) {
-            continue;
-        }
+    free(snake->body);
+    snake->body = body;
+    snake->capacity = capacity;
+    snake->head = snake->length - 1;
+
+    return true;
+}
 
-        // Draw each segment with safety checks
-        if (i == 0) {  // Head segment
-            DrawRectangle((int) (x * CELL_WIDTH), (int) (y * CELL_HEIGHT),
-                         CELL_WIDTH, CELL_HEIGHT, head_color);
-        } else {       // Body segments
-            DrawRectangle((int) (x * CELL_WIDTH), (int) (y * CELL_HEIGHT),
-                         CELL_WIDTH, CELL_HEIGHT, snake_color);
+/**
+ * @brief Grows the body buffer ahead of time so it can hold the given number of segments.
+ *
+ * @param snake A pointer to the Snake struct to grow.
+ * @param length The number of segments the buffer must hold.
+ *
+ * @return false if an allocation failed.
+ */
+bool reserve_snake(Snake *snake, int length) {
+    while (snake->capacity < length) {
+        if (!grow_body(snake)) {
+            return false;
         }
     }
-}
 
+    return true;
+}
 
 /**
- * @brief Draws a textured rectangle on the screen.
+ * @brief Moves the snake's head to the given cell.
  *
- * This function uses raylib's DrawTexturePro function to draw a textured rectangle on the screen.
- * The rectangle is positioned based on the provided position, and its size is determined by the CELL_WIDTH and CELL_HEIGHT constants.
- * The texture, color tint, and other rendering properties can be customized using the provided parameters.
+ * The new head is written into the next ring slot. Unless the snake grows, the tail is dropped
+ * at the same time, so a move is O(1) regardless of the snake's length.
  *
- * @param position The position of the top-left corner of the rectangle on the screen.
- * @param texture The texture to be used for rendering the rectangle.
- * @param tint The color tint to be applied to the texture.
+ * @param snake A pointer to the Snake struct to move.
+ * @param next The cell the head moves to.
+ * @param grow Whether the snake keeps its tail and becomes one segment longer.
  *
- * @return This function does not return any value.
+ * @return true if the snake grew, false otherwise.
  */
-void draw_textured_rectangle(Vector2 position, Texture2D texture, Color tint) {
-    Rectangle dest_rect = {(float) (position.x * (float) CELL_WIDTH), (float) (position.y * (float) CELL_HEIGHT),
-                           (float) CELL_WIDTH, (float) CELL_HEIGHT};
-    Rectangle source_rect = {0, 0, (float) texture.width, (float) texture.height};
-    Vector2 origin = {0, 0};
-    DrawTexturePro(texture, source_rect, dest_rect, origin, 0, tint);
+bool advance_snake(Snake *snake, Cell next, bool grow) {
+    if (grow && snake->length == snake->capacity && !grow_body(snake)) {
+        grow = false;
+    }
+
+    snake->head = (snake->head + 1) & (snake->capacity - 1);
+    snake->body[snake->head] = next;
+
+    if (grow) {
+        snake->length++;
+    }
+
+    return grow;
 }
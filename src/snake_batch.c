@@ -0,0 +1,414 @@
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include//clock.h"
+#include "../include//game.h"
+#include "../include//policy.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+#else
+
+#include <unistd.h>
+
+#endif
+
+#define USAGE_MSG "Usage: %s [--policy %s] [--cols N] [--rows N] [--games N] [--seed N] [--max-ticks N] [--threads N]\n"
+#define BATCH_ALLOC_ERROR "ERROR: Out of memory while allocating a batch of %d games\n"
+#define BATCH_THREAD_ERROR "ERROR: Could not start worker thread %d\n"
+
+#define DEFAULT_BATCH_GAMES 10000
+#define DEFAULT_BATCH_MAX_TICKS 100000
+#define BATCH_CHUNK 16            // Games per task; tasks are the unit of work stealing.
+#define MAX_BATCH_THREADS 256
+#define HISTOGRAM_BUCKETS 10
+#define HISTOGRAM_WIDTH 50
+
+/**
+ * @brief What the batch plays: one policy on one board size, for a range of seeds.
+ */
+typedef struct {
+    const Policy *policy;
+    int cols;
+    int rows;
+    int games;               // Game i is played with seed first_seed + i.
+    unsigned first_seed;
+    long max_ticks;          // Games still running after this many ticks are stopped.
+    int threads;
+    int32_t *scores;         // Score of each game, indexed like the seeds.
+} Batch;
+
+/**
+ * @brief A range of games, first to first + count - 1.
+ */
+typedef struct {
+    int first;
+    int count;
+} BatchTask;
+
+/**
+ * @brief A worker thread, its task deque and its share of the statistics.
+ *
+ * The owner takes tasks from the bottom of its deque and idle workers steal from the top, so
+ * workers only contend when one of them runs dry. Tasks never create new tasks, so a worker that
+ * finds every deque empty is done.
+ */
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;    // Guards top and bottom.
+    BatchTask *tasks;
+    int top;                 // First task not taken yet, thieves take from here.
+    int bottom;              // One past the last task not taken yet, the owner takes from here.
+    int index;
+    struct BatchWorkers *workers;
+
+    Autopilot search;        // Search buffers for the policy, reused for every game.
+
+    long long ticks;
+    double decide_time;      // Time spent in the policy, in seconds.
+    double decide_max;       // Longest decision, in seconds.
+    int died;
+    int won;
+    int timed_out;
+    int stolen;
+} BatchWorker;
+
+typedef struct BatchWorkers {
+    const Batch *batch;
+    BatchWorker *workers;
+    int count;
+} BatchWorkers;
+
+/**
+ * @brief Takes the newest task of the worker's own deque.
+ */
+static bool pop_task(BatchWorker *worker, BatchTask *task) {
+    bool found = false;
+
+    pthread_mutex_lock(&worker->lock);
+    if (worker->bottom > worker->top) {
+        *task = worker->tasks[--worker->bottom];
+        found = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return found;
+}
+
+/**
+ * @brief Takes the oldest task of another worker's deque, trying every other worker once.
+ */
+static bool steal_task(BatchWorker *thief, BatchTask *task) {
+    BatchWorkers *all = thief->workers;
+
+    for (int i = 1; i < all->count; i++) {
+        BatchWorker *victim = &all->workers[(thief->index + i) % all->count];
+        bool found = false;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->bottom > victim->top) {
+            *task = victim->tasks[victim->top++];
+            found = true;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (found) {
+            thief->stolen++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Plays one game of the batch to the end or to the tick limit.
+ *
+ * The game and the policy's generator are seeded from the game's index, so a game plays out the
+ * same way whichever thread runs it.
+ */
+static void play_game(BatchWorker *worker, Game *game, int index) {
+    const Batch *batch = worker->workers->batch;
+    long ticks = 0;
+
+    game->seed = batch->first_seed + (unsigned) index;
+    init_game(game);
+
+    Rng policy_rng;
+    rng_seed(&policy_rng, ~game->seed);
+
+    while (game->state == PLAYING && ticks < batch->max_ticks) {
+        double start = clock_now();
+        apply_policy(game, batch->policy, &policy_rng, &worker->search);
+        double elapsed = clock_now() - start;
+
+        worker->decide_time += elapsed;
+        if (elapsed > worker->decide_max) {
+            worker->decide_max = elapsed;
+        }
+
+        tick_game(game, tick_interval(game));
+        ticks++;
+    }
+
+    batch->scores[index] = game->snake.score;
+    worker->ticks += ticks;
+    worker->died += game->state == OVER;
+    worker->won += game->state == WON;
+    worker->timed_out += game->state == PLAYING;
+}
+
+static void *run_worker(void *arg) {
+    BatchWorker *worker = arg;
+    const Batch *batch = worker->workers->batch;
+
+    // One game per worker, reused for every game it plays: the board is allocated once
+    Game game = {0};
+    game.cols = batch->cols;
+    game.rows = batch->rows;
+
+    if (!init_autopilot(&worker->search, batch->cols, batch->rows)) {
+        return NULL;
+    }
+
+    BatchTask task;
+    while (pop_task(worker, &task) || steal_task(worker, &task)) {
+        for (int i = 0; i < task.count; i++) {
+            play_game(worker, &game, task.first + i);
+        }
+    }
+
+    free_game(&game);
+    free_autopilot(&worker->search);
+    return NULL;
+}
+
+static int compare_scores(const void *a, const void *b) {
+    int32_t x = *(const int32_t *) a;
+    int32_t y = *(const int32_t *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Returns the score below which the given fraction of the games fall, from sorted scores.
+ */
+static int32_t percentile(const int32_t *sorted, int count, double fraction) {
+    int i = (int) (fraction * (count - 1) + 0.5);
+    return sorted[i];
+}
+
+/**
+ * @brief Prints the aggregate statistics of a finished batch.
+ */
+static void print_stats(const Batch *batch, const BatchWorkers *all, double seconds) {
+    long long ticks = 0;
+    int died = 0, won = 0, timed_out = 0, stolen = 0;
+    double total = 0.0, decide_time = 0.0, decide_max = 0.0;
+
+    for (int i = 0; i < all->count; i++) {
+        ticks += all->workers[i].ticks;
+        decide_time += all->workers[i].decide_time;
+        if (all->workers[i].decide_max > decide_max) {
+            decide_max = all->workers[i].decide_max;
+        }
+        died += all->workers[i].died;
+        won += all->workers[i].won;
+        timed_out += all->workers[i].timed_out;
+        stolen += all->workers[i].stolen;
+    }
+
+    for (int i = 0; i < batch->games; i++) {
+        total += batch->scores[i];
+    }
+    qsort(batch->scores, batch->games, sizeof(int32_t), compare_scores);
+
+    const int32_t *scores = batch->scores;
+    const int games = batch->games;
+    double mean = total / games;
+    double variance = 0.0;
+    for (int i = 0; i < games; i++) {
+        variance += (scores[i] - mean) * (scores[i] - mean);
+    }
+    variance /= games;
+
+    printf("policy %s, board %dx%d, %d games (seeds %u..%u), %d threads, tick limit %ld\n",
+           batch->policy->name, batch->cols, batch->rows, games, batch->first_seed,
+           batch->first_seed + (unsigned) games - 1, all->count, batch->max_ticks);
+    printf("outcome: died %d, won %d, tick limit %d\n", died, won, timed_out);
+    printf("score: mean %.2f, stddev %.2f, min %d, p10 %d, p50 %d, p90 %d, p99 %d, max %d\n",
+           mean, sqrt(variance), scores[0], percentile(scores, games, 0.10),
+           percentile(scores, games, 0.50), percentile(scores, games, 0.90), percentile(scores, games, 0.99),
+           scores[games - 1]);
+    printf("time: %.3f s, %.0f games/s, %.0f ticks/s, %d tasks stolen\n",
+           seconds, games / seconds, ticks / seconds, stolen);
+    printf("decision: avg %.2f us, max %.2f us\n",
+           ticks > 0 ? decide_time / ticks * 1e6 : 0.0, decide_max * 1e6);
+
+    // Score distribution, in equal-width buckets from 0 to the best score
+    int32_t best = scores[games - 1];
+    int width = best / HISTOGRAM_BUCKETS + 1;
+    int counts[HISTOGRAM_BUCKETS] = {0};
+    int most = 0;
+
+    for (int i = 0; i < games; i++) {
+        int bucket = scores[i] / width;
+        bucket = bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+        counts[bucket]++;
+    }
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        most = counts[i] > most ? counts[i] : most;
+    }
+
+    for (int i = 0; i < HISTOGRAM_BUCKETS && i * width <= best; i++) {
+        int bar = (int) ((long long) counts[i] * HISTOGRAM_WIDTH / most);
+        printf("%6d-%-6d %8d |%.*s\n", i * width, (i + 1) * width - 1, counts[i], bar,
+               "##################################################");
+    }
+}
+
+/**
+ * @brief Returns the number of cores available to the process.
+ */
+static int core_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int) info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int) count : 1;
+#endif
+}
+
+/**
+ * @brief Parses the command line into the batch settings.
+ *
+ * @return false if an argument is unknown or malformed.
+ */
+static bool parse_args(int argc, char **argv, Batch *batch) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            return false;
+        }
+
+        const char *value = argv[++i];
+        char *endptr;
+        long number = strtol(value, &endptr, 10);
+        bool numeric = *endptr == '\0' && number >= 0;
+
+        if (strcmp(argv[i - 1], "--policy") == 0) {
+            batch->policy = find_policy(value);
+            if (batch->policy == NULL) {
+                return false;
+            }
+        } else if (strcmp(argv[i - 1], "--cols") == 0 && numeric && number <= BOARD_MAX_SIZE) {
+            batch->cols = (int) number;
+        } else if (strcmp(argv[i - 1], "--rows") == 0 && numeric && number <= BOARD_MAX_SIZE) {
+            batch->rows = (int) number;
+        } else if (strcmp(argv[i - 1], "--games") == 0 && numeric && number > 0 && number <= INT32_MAX / 2) {
+            batch->games = (int) number;
+        } else if (strcmp(argv[i - 1], "--seed") == 0 && numeric && number <= UINT32_MAX) {
+            batch->first_seed = (unsigned) number;
+        } else if (strcmp(argv[i - 1], "--max-ticks") == 0 && numeric && number > 0) {
+            batch->max_ticks = number;
+        } else if (strcmp(argv[i - 1], "--threads") == 0 && numeric && number > 0 && number <= MAX_BATCH_THREADS) {
+            batch->threads = (int) number;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Plays a batch of independent headless games on all cores and prints their statistics.
+ *
+ * @return 0 on successful execution, non-zero otherwise.
+ */
+int main(int argc, char **argv) {
+    Batch batch = {0};
+    batch.policy = find_policy("greedy");
+    batch.cols = DEFAULT_COLS;
+    batch.rows = DEFAULT_ROWS;
+    batch.games = DEFAULT_BATCH_GAMES;
+    batch.first_seed = 1;
+    batch.max_ticks = DEFAULT_BATCH_MAX_TICKS;
+    batch.threads = core_count();
+
+    if (!parse_args(argc, argv, &batch)) {
+        char names[128];
+        list_policies(names, sizeof(names));
+        fprintf(stderr, USAGE_MSG, argv[0], names);
+        return 1;
+    }
+
+    // Check the board size once, up front, instead of in every worker
+    Board board = {0};
+    if (!init_board(&board, batch.cols, batch.rows)) {
+        return 1;
+    }
+    free_board(&board);
+
+    int task_count = (batch.games + BATCH_CHUNK - 1) / BATCH_CHUNK;
+    BatchWorkers all = {&batch, calloc(batch.threads, sizeof(BatchWorker)), batch.threads};
+    batch.scores = malloc(batch.games * sizeof(int32_t));
+    BatchTask *tasks = malloc(task_count * sizeof(BatchTask));
+
+    if (all.workers == NULL || batch.scores == NULL || tasks == NULL) {
+        fprintf(stderr, BATCH_ALLOC_ERROR, batch.games);
+        return 1;
+    }
+
+    // Deal the tasks out in contiguous blocks; stealing evens out the games that run long
+    for (int w = 0; w < all.count; w++) {
+        BatchWorker *worker = &all.workers[w];
+        worker->index = w;
+        worker->workers = &all;
+        worker->tasks = tasks;
+        worker->top = (int) ((long long) task_count * w / all.count);
+        worker->bottom = (int) ((long long) task_count * (w + 1) / all.count);
+        pthread_mutex_init(&worker->lock, NULL);
+
+        for (int t = worker->top; t < worker->bottom; t++) {
+            tasks[t].first = t * BATCH_CHUNK;
+            tasks[t].count = batch.games - tasks[t].first < BATCH_CHUNK ? batch.games - tasks[t].first : BATCH_CHUNK;
+        }
+    }
+
+    double start = clock_now();
+
+    int started = 0;
+    for (; started < all.count; started++) {
+        if (pthread_create(&all.workers[started].thread, NULL, run_worker, &all.workers[started]) != 0) {
+            fprintf(stderr, BATCH_THREAD_ERROR, started);
+            break;
+        }
+    }
+
+    // Workers that did not start leave their tasks to be stolen by the others
+    for (int w = 0; w < started; w++) {
+        pthread_join(all.workers[w].thread, NULL);
+    }
+
+    double seconds = clock_now() - start;
+
+    int status = started > 0 ? 0 : 1;
+    if (status == 0) {
+        print_stats(&batch, &all, seconds);
+    }
+
+    for (int w = 0; w < all.count; w++) {
+        pthread_mutex_destroy(&all.workers[w].lock);
+    }
+    free(tasks);
+    free(batch.scores);
+    free(all.workers);
+
+    return status;
+}
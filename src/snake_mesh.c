@@ -0,0 +1,163 @@
+#include "../include//snake_mesh.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SNAKE_MESH_ALLOC_ERROR "ERROR: Out of memory while growing the snake mesh\n"
+
+/**
+ * @brief Returns the unit step from one cell to the next, (0, 0) if they are the same cell.
+ */
+static Cell step_between(Cell from, Cell to) {
+    Cell step = {(to.x > from.x) - (to.x < from.x), (to.y > from.y) - (to.y < from.y)};
+    return step;
+}
+
+static bool same_cell(Cell a, Cell b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+static bool adjacent(Cell a, Cell b) {
+    return abs(a.x - b.x) + abs(a.y - b.y) == 1;
+}
+
+/**
+ * @brief Initializes an empty mesh. The run buffer is allocated on first use.
+ *
+ * @param mesh A pointer to the SnakeMesh struct to initialize.
+ */
+void init_snake_mesh(SnakeMesh *mesh) {
+    mesh->runs = NULL;
+    mesh->capacity = 0;
+    mesh->first = 0;
+    mesh->count = 0;
+}
+
+/**
+ * @brief Releases the run buffer of the mesh.
+ *
+ * @param mesh A pointer to the SnakeMesh struct to release.
+ */
+void free_snake_mesh(SnakeMesh *mesh) {
+    free(mesh->runs);
+    init_snake_mesh(mesh);
+}
+
+/**
+ * @brief Appends a run at the head end, growing the ring buffer if needed.
+ */
+static void push_run(SnakeMesh *mesh, Cell from, Cell to) {
+    if (mesh->count == mesh->capacity) {
+        int capacity = mesh->capacity > 0 ? mesh->capacity * 2 : SNAKE_MESH_INITIAL_CAPACITY;
+        SnakeRun *runs = malloc(capacity * sizeof(SnakeRun));
+
+        if (runs == NULL) {
+            fprintf(stderr, SNAKE_MESH_ALLOC_ERROR);
+            exit(EXIT_FAILURE);
+        }
+
+        for (int i = 0; i < mesh->count; i++) {
+            runs[i] = *snake_mesh_run(mesh, i);
+        }
+
+        free(mesh->runs);
+        mesh->runs = runs;
+        mesh->capacity = capacity;
+        mesh->first = 0;
+    }
+
+    SnakeRun *run = &mesh->runs[(mesh->first + mesh->count) & (mesh->capacity - 1)];
+    run->from = from;
+    run->to = to;
+    mesh->count++;
+}
+
+/**
+ * @brief Rebuilds the mesh from the whole snake body, in O(length).
+ *
+ * @param mesh A pointer to the SnakeMesh struct to rebuild.
+ * @param snake A pointer to the Snake struct to mirror.
+ */
+void rebuild_snake_mesh(SnakeMesh *mesh, const Snake *snake) {
+    mesh->first = 0;
+    mesh->count = 0;
+
+    if (snake->body == NULL || snake->length <= 0) {
+        return;
+    }
+
+    Cell from = snake_tail(snake);
+    Cell to = from;
+
+    for (int i = snake->length - 2; i >= 0; i--) {
+        Cell next = snake_segment(snake, i);
+        Cell run_step = step_between(from, to);
+        Cell next_step = step_between(to, next);
+
+        // Start a new run at every corner; the corner cell ends one run and starts the next
+        if (!same_cell(from, to) && !same_cell(run_step, next_step)) {
+            push_run(mesh, from, to);
+            from = to;
+        }
+        to = next;
+    }
+
+    push_run(mesh, from, to);
+}
+
+/**
+ * @brief Brings the mesh up to date with the snake after a tick.
+ *
+ * If the head moved by one cell, the head run is extended when the snake keeps going straight
+ * and a new run is added when it turns. If the tail moved by one cell, the tail run is shortened
+ * and dropped once it is down to its shared corner cell. Anything else, such as a new game,
+ * triggers a full rebuild.
+ *
+ * @param mesh A pointer to the SnakeMesh struct to update.
+ * @param snake A pointer to the Snake struct to mirror.
+ */
+void sync_snake_mesh(SnakeMesh *mesh, const Snake *snake) {
+    if (mesh->count == 0) {
+        rebuild_snake_mesh(mesh, snake);
+        return;
+    }
+
+    Cell head = snake_head(snake);
+    Cell tail = snake_tail(snake);
+    SnakeRun *head_run = snake_mesh_run(mesh, mesh->count - 1);
+    SnakeRun *tail_run = snake_mesh_run(mesh, 0);
+
+    bool head_ok = same_cell(head, head_run->to) || adjacent(head, head_run->to);
+    bool tail_ok = same_cell(tail, tail_run->from) ||
+                   (adjacent(tail, tail_run->from) && !same_cell(tail_run->from, tail_run->to));
+
+    if (!head_ok || !tail_ok) {
+        rebuild_snake_mesh(mesh, snake);
+        return;
+    }
+
+    if (!same_cell(head, head_run->to)) {
+        Cell run_step = step_between(head_run->from, head_run->to);
+
+        if (same_cell(head_run->from, head_run->to) || same_cell(run_step, step_between(head_run->to, head))) {
+            head_run->to = head;
+        } else {
+            push_run(mesh, head_run->to, head);
+
+            // Growing the ring buffer moves the runs
+            tail_run = snake_mesh_run(mesh, 0);
+        }
+    }
+
+    if (!same_cell(tail, tail_run->from)) {
+        Cell run_step = step_between(tail_run->from, tail_run->to);
+        tail_run->from.x += run_step.x;
+        tail_run->from.y += run_step.y;
+
+        // Down to the corner shared with the next run: that run covers it already
+        if (same_cell(tail_run->from, tail_run->to) && mesh->count > 1) {
+            mesh->first = (mesh->first + 1) & (mesh->capacity - 1);
+            mesh->count--;
+        }
+    }
+}
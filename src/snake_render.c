@@ -0,0 +1,224 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include//framebuffer.h"
+#include "../include//game.h"
+#include "../include//policy.h"
+#include "../include//render_backend.h"
+#include "../include//window.h"
+
+#define USAGE_MSG "Usage: %s [--policy %s] [--cols N] [--rows N] [--seed N] [--ticks N] [--width N] [--height N]" \
+                  " [--output FILE] [--compare FILE] [--tolerance N]\n"
+#define RENDER_SETUP_ERROR "ERROR: Could not set up a %dx%d board and a %dx%d frame\n"
+#define RENDER_COMPARE_ERROR "ERROR: The frame differs from %s in %ld pixels\n"
+#define RENDER_SIZE_ERROR "ERROR: The frame is %dx%d, %s is %dx%d\n"
+#define RENDER_MESH_ERROR "ERROR: The snake mesh synced tick by tick differs from a rebuild at run %d of %d\n"
+
+#define DEFAULT_RENDER_TICKS 200
+#define MAX_RENDER_SIZE 8192
+
+/**
+ * @brief What to play and render, and where the frame goes.
+ */
+typedef struct {
+    const Policy *policy;
+    int cols;
+    int rows;
+    unsigned seed;
+    long ticks;              // Ticks played before the frame is drawn, fewer if the game ends.
+    int width;               // Frame size, in pixels.
+    int height;
+    const char *output;      // PNG written with the frame, or NULL.
+    const char *compare;     // Golden PNG the frame must match, or NULL.
+    int tolerance;           // Largest difference allowed in any channel of a pixel.
+} RenderJob;
+
+/**
+ * @brief Parses the command line into the render settings.
+ *
+ * @return false if an argument is unknown or malformed.
+ */
+static bool parse_args(int argc, char **argv, RenderJob *job) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            return false;
+        }
+
+        const char *value = argv[++i];
+        char *endptr;
+        long number = strtol(value, &endptr, 10);
+        bool numeric = *endptr == '\0' && number >= 0;
+
+        if (strcmp(argv[i - 1], "--policy") == 0) {
+            job->policy = find_policy(value);
+            if (job->policy == NULL) {
+                return false;
+            }
+        } else if (strcmp(argv[i - 1], "--cols") == 0 && numeric && number <= BOARD_MAX_SIZE) {
+            job->cols = (int) number;
+        } else if (strcmp(argv[i - 1], "--rows") == 0 && numeric && number <= BOARD_MAX_SIZE) {
+            job->rows = (int) number;
+        } else if (strcmp(argv[i - 1], "--seed") == 0 && numeric && number <= UINT32_MAX) {
+            job->seed = (unsigned) number;
+        } else if (strcmp(argv[i - 1], "--ticks") == 0 && numeric) {
+            job->ticks = number;
+        } else if (strcmp(argv[i - 1], "--width") == 0 && numeric && number > 0 && number <= MAX_RENDER_SIZE) {
+            job->width = (int) number;
+        } else if (strcmp(argv[i - 1], "--height") == 0 && numeric && number > 0 && number <= MAX_RENDER_SIZE) {
+            job->height = (int) number;
+        } else if (strcmp(argv[i - 1], "--output") == 0) {
+            job->output = value;
+        } else if (strcmp(argv[i - 1], "--compare") == 0) {
+            job->compare = value;
+        } else if (strcmp(argv[i - 1], "--tolerance") == 0 && numeric && number <= 255) {
+            job->tolerance = (int) number;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Draws a frame of a game the way the game window shows it, without the score.
+ */
+static void render_game(Framebuffer *frame, const Framebuffer *apple_sprite, const Game *game, SnakeMesh *mesh) {
+    RenderBackend backend = framebuffer_backend(frame);
+    RenderView view;
+
+    fit_render_view(&view, game->board.cols, game->board.rows, frame->width, frame->height);
+
+    clear_framebuffer(frame, RENDER_RAYWHITE);
+    draw_grid_lines(&backend, &view);
+    draw_snake_scene(&backend, &view, &game->snake, mesh, 1.0f);
+    draw_apple_scene(&backend, &view, &game->apple, apple_sprite);
+}
+
+/**
+ * @brief Checks a mesh synced tick by tick against one rebuilt from the whole snake.
+ *
+ * @return true if both have the same runs.
+ */
+static bool check_mesh(const SnakeMesh *synced, const Snake *snake) {
+    SnakeMesh rebuilt;
+    init_snake_mesh(&rebuilt);
+    rebuild_snake_mesh(&rebuilt, snake);
+
+    int i = 0;
+    while (i < synced->count && i < rebuilt.count) {
+        const SnakeRun *a = snake_mesh_run(synced, i);
+        const SnakeRun *b = snake_mesh_run(&rebuilt, i);
+        if (a->from.x != b->from.x || a->from.y != b->from.y || a->to.x != b->to.x || a->to.y != b->to.y) {
+            break;
+        }
+        i++;
+    }
+
+    bool same = i == synced->count && i == rebuilt.count;
+    if (!same) {
+        fprintf(stderr, RENDER_MESH_ERROR, i, rebuilt.count);
+    }
+
+    free_snake_mesh(&rebuilt);
+    return same;
+}
+
+/**
+ * @brief Compares a frame with a golden image and reports the difference.
+ *
+ * @return true if the frame matches within the tolerance.
+ */
+static bool check_frame(const Framebuffer *frame, const RenderJob *job) {
+    Framebuffer golden = {0};
+    if (!load_framebuffer_png(&golden, job->compare)) {
+        return false;
+    }
+
+    long differing = compare_framebuffers(frame, &golden, job->tolerance);
+    if (differing < 0) {
+        fprintf(stderr, RENDER_SIZE_ERROR, frame->width, frame->height, job->compare, golden.width, golden.height);
+    } else if (differing > 0) {
+        fprintf(stderr, RENDER_COMPARE_ERROR, job->compare, differing);
+    } else {
+        printf("frame matches %s\n", job->compare);
+    }
+
+    free_framebuffer(&golden);
+    return differing == 0;
+}
+
+/**
+ * @brief Plays a seeded game headless, renders its last frame with the CPU rasterizer, and writes it
+ * as a PNG or checks it against a golden image.
+ *
+ * The same seed, policy and board always give the same pixels, on any machine, so the frame can
+ * be checked in CI without a window or a GPU. The snake mesh is synced after every tick and checked
+ * against a full rebuild before it is drawn.
+ *
+ * @return 0 on success, non-zero if the frame could not be made, written, or does not match, or
+ *         if the synced mesh is wrong.
+ */
+int main(int argc, char **argv) {
+    RenderJob job = {0};
+    job.policy = find_policy("greedy");
+    job.cols = DEFAULT_COLS;
+    job.rows = DEFAULT_ROWS;
+    job.seed = 1;
+    job.ticks = DEFAULT_RENDER_TICKS;
+    job.width = (int) SCREEN_WIDTH;
+    job.height = (int) SCREEN_HEIGHT;
+
+    if (!parse_args(argc, argv, &job) || (job.output == NULL && job.compare == NULL)) {
+        char names[128];
+        list_policies(names, sizeof(names));
+        fprintf(stderr, USAGE_MSG, argv[0], names);
+        return 1;
+    }
+
+    Game game = {0};
+    Autopilot search = {0};
+    Framebuffer frame = {0};
+    Framebuffer apple_sprite = {0};
+    SnakeMesh mesh;
+    init_snake_mesh(&mesh);
+
+    game.cols = job.cols;
+    game.rows = job.rows;
+    game.seed = job.seed;
+
+    int status = 1;
+    if (!init_game(&game) || !init_autopilot(&search, job.cols, job.rows) ||
+        !init_framebuffer(&frame, job.width, job.height) || !build_apple_sprite(&apple_sprite, (int) CELL_SIZE)) {
+        fprintf(stderr, RENDER_SETUP_ERROR, job.cols, job.rows, job.width, job.height);
+    } else {
+        Rng policy_rng;
+        rng_seed(&policy_rng, ~game.seed);
+
+        // The mesh follows the snake tick by tick, as in the game window
+        for (long t = 0; t < job.ticks && game.state == PLAYING; t++) {
+            apply_policy(&game, job.policy, &policy_rng, &search);
+            tick_game(&game, tick_interval(&game));
+            sync_snake_mesh(&mesh, &game.snake);
+        }
+
+        status = check_mesh(&mesh, &game.snake) ? 0 : 1;
+        render_game(&frame, &apple_sprite, &game, &mesh);
+
+        if (job.output != NULL && !save_framebuffer_png(&frame, job.output)) {
+            status = 1;
+        }
+        if (job.compare != NULL && !check_frame(&frame, &job)) {
+            status = 1;
+        }
+    }
+
+    free_snake_mesh(&mesh);
+    free_framebuffer(&apple_sprite);
+    free_framebuffer(&frame);
+    free_autopilot(&search);
+    free_game(&game);
+
+    return status;
+}
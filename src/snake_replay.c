@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include "../include//clock.h"
+#include "../include//game.h"
+#include "../include//replay.h"
+
+#define USAGE_MSG "Usage: %s FILE.snrp...\n"
+#define REPLAY_MISMATCH_WARNING "WARNING: %s does not play back to its recorded outcome (%d ticks, score %d, length %d)\n"
+
+/**
+ * @brief Plays replay files back headless, as fast as the simulation runs, and checks each one
+ * ends with the score and length it was recorded with.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The replay files to play.
+ *
+ * @return 0 if every replay plays back to its recorded outcome, 1 otherwise.
+ */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, USAGE_MSG, argv[0]);
+        return 1;
+    }
+
+    Replay replay = {0};
+    Game game = {0};
+    int failed = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!load_replay(&replay, argv[i])) {
+            failed++;
+            continue;
+        }
+
+        const ReplayHeader *header = &replay.header;
+        double start = clock_now();
+        bool ok = verify_replay(&replay, &game);
+        double seconds = clock_now() - start;
+
+        printf("%s: seed %llu, %dx%d, %u ticks, score %d, length %d, %u turns in %u bytes, %.0f ticks/s\n",
+               argv[i], (unsigned long long) header->seed, header->cols, header->rows, header->ticks,
+               header->score, header->length, header->event_count,
+               (unsigned) sizeof(ReplayHeader) + header->data_size,
+               seconds > 0.0 ? header->ticks / seconds : 0.0);
+
+        if (!ok) {
+            fprintf(stderr, REPLAY_MISMATCH_WARNING, argv[i], header->ticks, game.snake.score, game.snake.length);
+            failed++;
+        }
+    }
+
+    free_replay(&replay);
+    free_game(&game);
+
+    return failed > 0;
+}
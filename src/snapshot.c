@@ -0,0 +1,242 @@
+#include "../include//snapshot.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SNAPSHOT_ALLOC_WARNING "WARNING: Not enough memory for snapshots of a %dx%d board, rewinding is disabled\n"
+
+/**
+ * @brief Start of a snapshot, followed by the board and body arrays at fixed offsets.
+ *
+ * The pointers inside the copied game are never used: restoring keeps the target game's own.
+ */
+typedef struct {
+    Game game;
+} SnapshotHeader;
+
+/**
+ * @brief Offsets of the arrays of a snapshot, which depend only on the board size.
+ */
+typedef struct {
+    size_t occupied;    // uint64_t[words], the board's occupancy bits.
+    size_t body;        // Cell[cells], the snake from tail to head.
+    size_t free_cells;  // int32_t[cells], the first free_count entries of the board's free cells.
+    size_t words;
+    size_t size;
+} SnapshotLayout;
+
+/**
+ * @brief Computes the offsets of the arrays of a snapshot for a board of the given size.
+ */
+static SnapshotLayout snapshot_layout(int cols, int rows) {
+    SnapshotLayout layout;
+    size_t cells = (size_t) cols * rows;
+
+    layout.words = (cells + 63) / 64;
+    layout.occupied = sizeof(SnapshotHeader);
+    layout.body = layout.occupied + layout.words * sizeof(uint64_t);
+    layout.free_cells = layout.body + cells * sizeof(Cell);
+    // Rounded up so the snapshots of a ring stay 8-byte aligned
+    layout.size = (layout.free_cells + cells * sizeof(int32_t) + 7) & ~(size_t) 7;
+
+    return layout;
+}
+
+/**
+ * @brief Returns the size of a snapshot of a game on a board of the given size.
+ */
+size_t snapshot_size(int cols, int rows) {
+    return snapshot_layout(cols, rows).size;
+}
+
+/**
+ * @brief Copies the whole state of a game into a snapshot.
+ *
+ * Does not allocate; only the live part of the arrays is copied.
+ *
+ * @param snapshot A buffer of snapshot_size() bytes for the game's board size, 8-byte aligned.
+ * @param game A pointer to the game to copy.
+ */
+void take_snapshot(void *snapshot, const Game *game) {
+    SnapshotLayout layout = snapshot_layout(game->board.cols, game->board.rows);
+    unsigned char *bytes = snapshot;
+    const Snake *snake = &game->snake;
+
+    ((SnapshotHeader *) snapshot)->game = *game;
+
+    memcpy(bytes + layout.occupied, game->board.occupied, layout.words * sizeof(uint64_t));
+
+    // Unroll the body ring from tail to head in at most two copies
+    Cell *body = (Cell *) (bytes + layout.body);
+    int start = (snake->head - snake->length + 1) & (snake->capacity - 1);
+    int first = snake->capacity - start < snake->length ? snake->capacity - start : snake->length;
+    memcpy(body, snake->body + start, first * sizeof(Cell));
+    memcpy(body + first, snake->body, (snake->length - first) * sizeof(Cell));
+
+    memcpy(bytes + layout.free_cells, game->board.free_cells, game->board.free_count * sizeof(int32_t));
+}
+
+/**
+ * @brief Puts a game back in the state saved in a snapshot.
+ *
+ * The game keeps its own buffers. Nothing is allocated unless the game's snake body is too small
+ * for the snapshot's snake, which cannot happen when restoring a snapshot of the same game.
+ *
+ * @param snapshot A snapshot written by take_snapshot().
+ * @param game A pointer to an initialized game on a board of the same size.
+ *
+ * @return false if the board sizes differ or the snake body could not be grown.
+ */
+bool restore_snapshot(const void *snapshot, Game *game) {
+    const Game *saved = &((const SnapshotHeader *) snapshot)->game;
+    const unsigned char *bytes = snapshot;
+
+    if (saved->board.cols != game->board.cols || saved->board.rows != game->board.rows ||
+        !reserve_snake(&game->snake, saved->snake.length)) {
+        return false;
+    }
+
+    SnapshotLayout layout = snapshot_layout(game->board.cols, game->board.rows);
+    Board board = game->board;
+    Cell *body = game->snake.body;
+    int capacity = game->snake.capacity;
+
+    *game = *saved;
+    game->board = board;
+    game->board.free_count = saved->board.free_count;
+    game->snake.body = body;
+    game->snake.capacity = capacity;
+    game->snake.head = saved->snake.length - 1;
+
+    memcpy(board.occupied, bytes + layout.occupied, layout.words * sizeof(uint64_t));
+    memcpy(body, bytes + layout.body, saved->snake.length * sizeof(Cell));
+    memcpy(board.free_cells, bytes + layout.free_cells, saved->board.free_count * sizeof(int32_t));
+
+    // Only the slots of free cells are ever read, so they are rebuilt instead of stored
+    for (int i = 0; i < saved->board.free_count; i++) {
+        board.free_slot[board.free_cells[i]] = i;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Allocates a ring of snapshots for games on a board of the given size.
+ *
+ * The ring holds at most capacity snapshots, fewer if they would take more than
+ * SNAPSHOT_RING_MAX_BYTES. A ring that was already initialized is released first.
+ *
+ * @param ring A pointer to the SnapshotRing struct to initialize; zero it before the first call.
+ * @param cols The number of columns of the board.
+ * @param rows The number of rows of the board.
+ * @param capacity The number of snapshots wanted.
+ *
+ * @return false if not even one snapshot could be allocated.
+ */
+bool init_snapshot_ring(SnapshotRing *ring, int cols, int rows, int capacity) {
+    free_snapshot_ring(ring);
+
+    size_t slot_size = snapshot_size(cols, rows);
+    if ((size_t) capacity > SNAPSHOT_RING_MAX_BYTES / slot_size) {
+        capacity = (int) (SNAPSHOT_RING_MAX_BYTES / slot_size);
+    }
+
+    ring->slots = capacity > 0 ? malloc(capacity * slot_size) : NULL;
+    if (ring->slots == NULL) {
+        fprintf(stderr, SNAPSHOT_ALLOC_WARNING, cols, rows);
+        return false;
+    }
+
+    ring->slot_size = slot_size;
+    ring->capacity = capacity;
+    ring->cols = cols;
+    ring->rows = rows;
+    clear_snapshot_ring(ring);
+
+    return true;
+}
+
+/**
+ * @brief Releases the memory of a ring of snapshots.
+ *
+ * @param ring A pointer to the SnapshotRing struct to release.
+ */
+void free_snapshot_ring(SnapshotRing *ring) {
+    free(ring->slots);
+    memset(ring, 0, sizeof(*ring));
+}
+
+/**
+ * @brief Drops every snapshot of a ring, keeping its memory.
+ *
+ * @param ring A pointer to the SnapshotRing struct to clear.
+ */
+void clear_snapshot_ring(SnapshotRing *ring) {
+    ring->count = 0;
+    ring->newest = ring->capacity - 1;
+}
+
+/**
+ * @brief Adds a snapshot of a game to a ring, overwriting the oldest one if the ring is full.
+ *
+ * Does nothing if the ring was not allocated or was allocated for another board size.
+ *
+ * @param ring A pointer to the SnapshotRing.
+ * @param game A pointer to the game to copy.
+ */
+void push_snapshot(SnapshotRing *ring, const Game *game) {
+    if (ring->slots == NULL || game->board.cols != ring->cols || game->board.rows != ring->rows) {
+        return;
+    }
+
+    ring->newest = ring->newest + 1 < ring->capacity ? ring->newest + 1 : 0;
+    if (ring->count < ring->capacity) {
+        ring->count++;
+    }
+
+    take_snapshot(ring->slots + ring->newest * ring->slot_size, game);
+}
+
+/**
+ * @brief Puts a game back in the state of one of the snapshots of a ring, keeping the ring as is.
+ *
+ * @param ring A pointer to the SnapshotRing.
+ * @param age Which snapshot to restore, 0 being the newest and count - 1 the oldest.
+ * @param game A pointer to the game to restore, see restore_snapshot().
+ *
+ * @return false if there is no such snapshot or it cannot be restored into this game.
+ */
+bool restore_from_ring(const SnapshotRing *ring, int age, Game *game) {
+    if (age < 0 || age >= ring->count) {
+        return false;
+    }
+
+    int slot = ring->newest - age;
+    if (slot < 0) {
+        slot += ring->capacity;
+    }
+
+    return restore_snapshot(ring->slots + slot * ring->slot_size, game);
+}
+
+/**
+ * @brief Steps a game one snapshot back: drops the newest snapshot and restores the one before it.
+ *
+ * With one snapshot pushed after each tick, each call undoes one tick.
+ *
+ * @param ring A pointer to the SnapshotRing.
+ * @param game A pointer to the game to restore.
+ *
+ * @return false, leaving the ring and the game unchanged, if there is no older snapshot.
+ */
+bool rewind_ring(SnapshotRing *ring, Game *game) {
+    if (ring->count < 2 || !restore_from_ring(ring, 1, game)) {
+        return false;
+    }
+
+    ring->newest = ring->newest > 0 ? ring->newest - 1 : ring->capacity - 1;
+    ring->count--;
+
+    return true;
+}
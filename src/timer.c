@@ -1,5 +1,4 @@
 #include "../include//timer.h"
-#include "raylib.h"
 #include <stdbool.h>
 
 /**
@@ -32,19 +31,20 @@ void reset_timer(Timer *timer, double duration) {
 }
 
 /**
- * @brief Updates the timer by subtracting the time elapsed since the last frame.
+ * @brief Updates the timer by subtracting the time elapsed since the last update.
  *
  * This function checks if the timer is active and has a positive lifetime.
- * If both conditions are met, it decreases the lifetime by the time elapsed since the last frame.
- * This function is typically called in the game loop to keep the timer running accurately.
+ * If both conditions are met, it decreases the lifetime by the given elapsed time.
+ * The caller supplies the elapsed time so the timer does not depend on a window's frame clock.
  *
  * @param timer A pointer to the Timer struct to update.
+ * @param dt The time elapsed since the last update, in seconds.
  *
  * @return This function does not return any value.
  */
-void update_timer(Timer *timer) {
+void update_timer(Timer *timer, double dt) {
     if (timer->active && timer->lifetime > 0) {
-        timer->lifetime -= GetFrameTime();
+        timer->lifetime -= dt;
     }
 }
 